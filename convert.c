@@ -0,0 +1,168 @@
+/*
+ * Converter between the text files of the DSP tests (one sample per line, as wave.txt and spectrum.txt) and the binary files of dspIO.h, which also
+ * restores the text of compressed spectra. All routines are meant to be called from the VxWorks shell, for instance:
+ * -> textToBinary "wave.txt", "wave.bin", 256, 8000
+ * -> binaryToText "wave.bin", "wave.txt"
+ * -> compressedToText "spectrum.dspz", "spectrum.txt"
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* VxWorks libraries */
+
+#include "ioLib.h" 									/*I/O interface library*/
+
+/* Generic libraries */
+
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+#include "string.h" 								/*For strstr(); utility*/
+
+/* Project libraries */
+
+#include "lib/dspIO.h"
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Convert the text file 'source' into the binary file 'destination', with frames of 'length' samples taken at 'rate' Hz. Samples are complex if the first
+ * line is written as 'a + j(b)', real otherwise. As in the acquisition from text, malformed samples are set to 0 and an incomplete last frame is dropped */
+
+STATUS textToBinary (const char * const source, const char * const destination, const unsigned int length, const unsigned int rate) {
+
+	binaryHeader header;
+	fileReader *reader = NULL;
+	double *frame = NULL;
+	char *line;
+	int input, output;
+	unsigned int frames = 0;
+	unsigned int malformed = 0;
+	unsigned int filled = 0;
+	STATUS st = OK;
+
+	if (length == 0 || length > BINARY_MAX_VALUES/2) return ERROR; 							/*Complex frames take 2*length doubles*/
+
+	if ((input = open ((char*)source, O_RDONLY, 0444)) == ERROR) return ERROR;
+	if ((output = open ((char*)destination, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) {
+		close (input);
+		return ERROR;
+	}
+
+	reader = readerCreate (input, READER_BLOCK);
+	frame = (double*)malloc ((size_t)2*length*sizeof (double)); 							/*Enough for complex samples*/
+	line = (reader != NULL) ? readerLine (reader) : NULL;
+	if (frame == NULL || line == NULL) st = ERROR;
+
+	header.type = (line != NULL && strstr (line, "j(") != NULL) ? SAMPLE_COMPLEX : SAMPLE_REAL;
+	header.length = length;
+	header.rate = rate;
+	header.channels = 1;
+	if (st == OK) st = sendHeaderToFile (output, &header);
+
+	while (st == OK && line != NULL) {
+		if (header.type == SAMPLE_COMPLEX) {
+			if (parseComplex (line, (complex*)frame + filled) != OK) malformed++;
+		}
+		else if (parseFixed (line, frame + filled) != OK) malformed++;
+		if (++filled == length) { 															/*A whole frame: write it*/
+			st = sendBinaryToFile (output, frame, binaryValues (&header));
+			filled = 0;
+			frames++;
+		}
+		line = readerLine (reader);
+	}
+
+	printf ("%s: %u frames of %u %s samples, %u malformed.\n", destination, frames, length, (header.type == SAMPLE_COMPLEX) ? "complex" : "real",
+		malformed);
+
+	free (frame);
+	if (reader != NULL) readerDestroy (reader);
+	close (input);
+	close (output);
+
+	return st;
+
+}
+
+/* Convert the binary file 'source' into the text file 'destination', in the format of sendToFile(); for complex samples and of sendRealToFile(); for real
+ * ones (channel after channel for each frame). An incomplete last frame is dropped */
+
+STATUS binaryToText (const char * const source, const char * const destination) {
+
+	binaryHeader header;
+	double *frame;
+	int input, output;
+	unsigned int frames = 0;
+	STATUS st;
+
+	if ((input = open ((char*)source, O_RDONLY, 0444)) == ERROR) return ERROR;
+	if ((st = acquireHeaderFromFile (input, &header)) != OK) {
+		close (input);
+		return st;
+	}
+	if ((output = open ((char*)destination, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) {
+		close (input);
+		return ERROR;
+	}
+
+	frame = (double*)malloc ((size_t)binaryValues (&header)*sizeof (double)); 				/*The header has been validated: no overflows*/
+	st = (frame != NULL) ? OK : ERROR;
+
+	while (st == OK && acquireFromBinaryFile (input, frame, binaryValues (&header)) == OK) {
+		if (header.type == SAMPLE_COMPLEX) sendToFile (output, (complex*)frame, header.length*header.channels);
+		else sendRealToFile (output, frame, header.length*header.channels);
+		frames++;
+	}
+
+	printf ("%s: %u frames of %u %s samples, %u channels, %u Hz.\n", destination, frames, header.length,
+		(header.type == SAMPLE_COMPLEX) ? "complex" : "real", header.channels, header.rate);
+
+	free (frame);
+	close (input);
+	close (output);
+
+	return st;
+
+}
+
+/* Convert the compressed file 'source' (see spectrumCodec in dspIO.h) into the text file 'destination', in the format of sendToFile(); for complex bins
+ * and of sendRealToFile(); for real ones. Frames are decoded one at a time, as they are read */
+
+STATUS compressedToText (const char * const source, const char * const destination) {
+
+	spectrumCodec *decoder;
+	double *frame;
+	int input, output;
+	STATUS st;
+
+	if ((input = open ((char*)source, O_RDONLY, 0444)) == ERROR) return ERROR;
+	if ((decoder = decoderCreate (input)) == NULL) {
+		close (input);
+		return BAD_FORMAT;
+	}
+	if ((output = open ((char*)destination, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) {
+		codecDestroy (decoder);
+		close (input);
+		return ERROR;
+	}
+
+	frame = (double*)malloc (decoder->values*sizeof (double));
+	st = (frame != NULL) ? OK : ERROR;
+
+	while (st == OK && (st = acquireFromDecoder (decoder, frame)) == OK) {
+		if (decoder->type == SAMPLE_COMPLEX) sendToFile (output, (complex*)frame, decoder->bins);
+		else sendRealToFile (output, frame, decoder->bins);
+	}
+	if (st == EOF_REACHED) st = OK;
+
+	printf ("%s: %u frames of %u %s bins, precision %g, %llu bytes.\n", destination, decoder->frames, decoder->bins,
+		(decoder->type == SAMPLE_COMPLEX) ? "complex" : "real", decoder->precision, decoder->bytes);
+
+	free (frame);
+	codecDestroy (decoder);
+	close (input);
+	close (output);
+
+	return st;
+
+}
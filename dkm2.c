@@ -16,6 +16,9 @@
 #include "lib/synctask.h"
 #include "lib/dsp.h"
 #include "lib/dspIO.h"
+#include "lib/dspAsync.h"
+#include "lib/dspFrame.h"
+#include "lib/dspStream.h"
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
 /* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
@@ -33,10 +36,37 @@
 
 #define FLAGS										SYNC_INVERSION_SAFE
 
-/* Length of a frame for FFT computation (use a power of 2). Computation length of 'task1' is affected by this parameter */
+/* Length of a frame for FFT computation (any even length; powers of 2 are the fastest, and the only ones allowed by PRECISION_FLOAT and PRECISION_Q15).
+ * Computation length of 'task1' is affected by this parameter */
 
 #define FRAME_LENGTH								256
 
+/* Samples acquired by 'task0' at each period, and transformed frames overlap by FRAME_LENGTH-HOP_LENGTH samples (FRAME_LENGTH must be a multiple of it) */
+
+#define HOP_LENGTH 									64
+
+/* Analysis window applied to each frame */
+
+#define WINDOW 										WINDOW_HANN
+
+/* Precision of the transform (PRECISION_DOUBLE, PRECISION_FLOAT or PRECISION_Q15), and full-scale value of the waveform (mapped to 1 in Q15 format) */
+
+#define PRECISION 									PRECISION_DOUBLE
+#define FULL_SCALE 									10.0
+
+/* Evaluate the transforms of 'task1' by the FFT planned by the STFT, instead of sft(); (the algebraic definition, in O(n^2) time and PRECISION_DOUBLE
+ * only). No task is started if the selected transform isn't available */
+
+#define FFT_TRANSFORM 								true
+
+/* Spectra averaged into each output (0 to send the complex bins of every transform), averaging method, weight of the last spectrum (exponential
+ * averaging only) and reduction of the averaged power (magnitude, power or dB) */
+
+#define AVERAGE_FRAMES 								0
+#define AVERAGING 									AVERAGING_WELCH
+#define ALPHA 										0.25
+#define REDUCTION 									REDUCTION_DB
+
 /* Server IP Address */
 
 #define SERVER_IP_ADDRESS 							"127.0.0.1"
@@ -45,42 +75,156 @@
 
 #define SERVER_PORT_NUM 							5002
 
+/* Send UDP frames of binary samples (see udpSender in dspIO.h) instead of a datagram of text for each sample */
+
+#define PACKED_UDP 									false
+
+/* Priority of the I/O workers of dspAsync.h, below every periodic task */
+
+#define IO_PRIO 									(MAX_USER_PRIO + NT)
+
+/* Push spectra and UDP samples into asynchronous sinks (see asyncSink in dspAsync.h) instead of writing them within the periodic activity: records which
+ * find a ring full are dropped, so that a slow device never causes a deadline miss */
+
+#define ASYNC_OUTPUT 								false
+#define SPECTRUM_SLOTS 								16
+#define SAMPLE_SLOTS 								1024
+
+/* Frames of the pool shared by the tasks: a hop handed by 'task0' to 'task2' and a spectrum of 'task1' are held at a time, plus slack for the overlap of
+ * periods and the hops parsed ahead (if PREFETCH_INPUT) */
+
+#define POOL_FRAMES 								(4 + (PREFETCH_INPUT ? PREFETCH_BUFFERS : 0))
+
 /* Input and output files */
 
 #define INPUT_FILE 									"wave.txt"
 #define OUTPUT_FILE 								"spectrum.txt"
 
+/* Write spectra to COMPRESSED_FILE, quantized to multiples of OUTPUT_PRECISION (see spectrumCodec in dspIO.h), instead of OUTPUT_FILE: 0.0001 keeps the
+ * decimals of the text. It can be converted to text by compressedToText(); (see convert.c) */
+
+#define COMPRESSED_OUTPUT 							false
+#define COMPRESSED_FILE 							"spectrum.dspz"
+#define OUTPUT_PRECISION 							0.0001
+
+/* Map the input file into memory instead of reading it by blocks (for offline replays of large captures) */
+
+#define MAP_INPUT 									false
+
+/* Parse the input file ahead of 'task0' into up to PREFETCH_BUFFERS frames of 'frames' (see prefetchSource in dspAsync.h, and the pool gets as many frames
+ * more), so that an acquisition just hands over a hop already parsed */
+
+#define PREFETCH_INPUT 								false
+#define PREFETCH_BUFFERS 							8
+
+/* Acquire the waveform from UDP frames sent to INPUT_PORT_NUM (see udpReceiver in dspIO.h) instead of INPUT_FILE: datagrams are reassembled in a window
+ * of INPUT_WINDOW samples, samples still missing once INPUT_SLACK later ones have arrived are given up, and the input ends after INPUT_TIMEOUT ms of silence */
+
+#define UDP_INPUT 									false
+#define INPUT_PORT_NUM 								5001
+#define INPUT_WINDOW 								4096
+#define INPUT_SLACK 								1024
+#define INPUT_TIMEOUT 								1000
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
 /* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
-int input; 																					/*Handle of device waveform comes from*/
-int output; 																				/*Handle of device where spectrum has to be sent*/
-int UDPSocket; 																				/*Handle of UDP socket*/
-
-boolean inputAvailable; 																	/*Used to broadcast when input is not available anymore*/
-
-double frameT[FRAME_LENGTH]; 																/*Frame where time samples are put before being processed by FFT*/
-double frameT_[FRAME_LENGTH]; 																/*Buffer used by 'task1'*/
-complex frameF[FRAME_LENGTH]; 																/*Frame where frequency samples are put before being sent*/
+static int input; 																			/*Handle of device waveform comes from*/
+static fileReader *reader; 																	/*Buffered reader of 'input'...*/
+static fileMapping *mapping; 																/*...or its mapping (if MAP_INPUT)...*/
+static prefetchSource *prefetch; 															/*...or a source parsing it ahead (if PREFETCH_INPUT)*/
+static int inputSocket; 																	/*Handle of UDP socket waveform comes from (if UDP_INPUT)...*/
+static udpReceiver *receiver; 																/*...and its receiver*/
+static int output; 																			/*Handle of device where spectrum has to be sent*/
+static fileWriter *writer; 																	/*Buffered writer of 'output': a write(); for each spectrum...*/
+static asyncSink *spectrumSink; 															/*...or its asynchronous sink (if ASYNC_OUTPUT)...*/
+static spectrumCodec *encoder; 																/*...or an encoder of compressed spectra (if COMPRESSED_OUTPUT)*/
+static int UDPSocket; 																		/*Handle of UDP socket*/
+static udpSender *sender; 																	/*Sender of UDP frames through 'UDPSocket' (if PACKED_UDP)...*/
+static asyncSink *sampleSink; 																/*...or asynchronous sink of its datagrams (if ASYNC_OUTPUT)*/
+
+static framePool *frames; 																	/*Frames handed among the tasks (see dspFrame.h)*/
+static unsigned int poolUsers; 																/*Tasks still using 'frames' ('task1' and 'task2')*/
+static frameSource *source; 																/*Source of hops from whichever device above*/
+static frameSink *spectrumOut; 																/*Sink of spectra, to 'writer', 'spectrumSink' or 'encoder'*/
+static frameSink *sampleOut; 																/*Sink of hops, to 'sender', 'sampleSink' or 'UDPSocket'*/
+
+static boolean inputAvailable; 																/*Used to broadcast when input is not available anymore*/
+
+static dspFrame *hop; 																		/*Last hop acquired by 'task0', handed to 'task2' (which releases it)*/
+static complexf frameF_[FRAME_LENGTH/2+1]; 													/*Bins in single precision (if PRECISION_FLOAT)...*/
+static complexq15 frameQ15_[FRAME_LENGTH/2+1]; 												/*...or in Q15 format (if PRECISION_Q15), converted into a frame*/
+static complex frameS_[FRAME_LENGTH]; 														/*All the bins evaluated by sft(); (unless FFT_TRANSFORM)*/
+
+static stft *stream; 																		/*STFT stage: 'task0' acquires hops into it, 'task1' transforms its overlapped frames*/
+static unsigned int completed; 																/*Complete frames committed by 'task0' into 'stream' (one per hop)...*/
+static unsigned int transformed; 															/*...number of the last one transformed by 'task1'...*/
+static unsigned int missed; 																/*...and of the ones overwritten before 'task1' could transform them*/
+static spectrumAverage *average; 															/*Averaging stage of 'task1' (only if AVERAGE_FRAMES>0)*/
 
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/* Release 'frames' once both 'task1' and 'task2' have stopped using it */
+
+void leavePool () {
+
+	boolean last;
+
+	taskLock();
+	last = (--poolUsers == 0);
+	taskUnlock();
+
+	if (last) poolDestroy (frames);
+
+}
+
 /* Exit activity for generic periodic task */
 
 void exitActivity (const int i) {
 
 	switch (i) {
 		case (0):
-			close (input);
+			if (source != NULL) frameSourceDestroy (source);
+			if (reader != NULL) readerDestroy (reader);
+			if (mapping != NULL) mappingDestroy (mapping);
+			if (prefetch != NULL) {
+				printf ("task0 has found no prefetched hop %u times.\n", prefetch->starved);
+				prefetchDestroy (prefetch);
+			}
+			if (receiver != NULL) receiverDestroy (receiver);
+			if (UDP_INPUT) close (inputSocket);
+			else close (input);
 			break;
 		case (1):
+			if (spectrumOut != NULL) frameSinkDestroy (spectrumOut);
+			if (writer != NULL) writerDestroy (writer);
+			if (encoder != NULL) {
+				printf ("task1 has written %u spectra in %llu bytes.\n", encoder->frames, encoder->bytes);
+				codecDestroy (encoder);
+			}
+			if (spectrumSink != NULL) {
+				printf ("task1 has dropped %u spectra.\n", spectrumSink->dropped);
+				sinkDestroy (spectrumSink); 												/*Waiting spectra are written first*/
+			}
+			printf ("task1 has missed %u frames.\n", missed);
 			close (output);
+			stftDestroy (stream); 															/*'task0' has already exited: 'stream' isn't used anymore*/
+			if (average != NULL) averageDestroy (average);
+			leavePool();
 			break;
 		case (2):
+			if (hop != NULL) frameRelease (hop); 											/*Acquired by the last period of 'task0'*/
+			if (sampleOut != NULL) frameSinkDestroy (sampleOut);
+			if (sender != NULL) senderDestroy (sender);
+			if (sampleSink != NULL) {
+				printf ("task2 has dropped %u samples.\n", sampleSink->dropped);
+				sinkDestroy (sampleSink);
+			}
 			close (UDPSocket);
+			leavePool();
 			break;
 		default:
 			break;
@@ -104,27 +248,86 @@ void deadlineMissActivity (const int i, const task_attr_t * const attr) {
 
 void periodicActivity (const int i) {
 
+	dspFrame *frame;
+	unsigned int sequence;
+	STATUS st;
+
 	switch (i) {
 		case (0):
-			if (acquireFromFile (input, frameT, FRAME_LENGTH) == EOF_REACHED) { 			/*Put waveform samples in memory ('frameT')*/
+			st = sourceAcquire (source, &frame); 											/*Whichever the device, a hop comes in a frame of 'frames'*/
+			if (st == EOF_REACHED) {
 				inputAvailable = false;
 				exitActivity (0);
 			}
-			task_wait (task_get ("task2"), GENERIC, FLAGS); 								/*Wait for 'task2' sending data in 'frameT'*/
+			if (st == MALFORMED_SAMPLE) printf ("task0 has acquired malformed samples, set to 0.\n");
+			if (frame != NULL) { 															/*Otherwise nothing has been acquired in this period*/
+				switch (PRECISION) { 														/*The STFT keeps its own overlapped history, in its precision*/
+					case (PRECISION_FLOAT):
+						floatFromReal (frame->samples, stftSlotFloat (stream), HOP_LENGTH);
+						break;
+					case (PRECISION_Q15):
+						q15FromReal (frame->samples, stftSlotQ15 (stream), HOP_LENGTH, FULL_SCALE);
+						break;
+					default:
+						frmcpy (frame->samples, stftSlot (stream), HOP_LENGTH);
+						break;
+				}
+				taskLock();
+				if (stftPush (stream) == OK) completed++; 									/*Commit the hop: the current frame now ends with it*/
+				taskUnlock();
+				hop = frame; 																/*Handed to 'task2' by reference*/
+			}
+			task_wait (task_get ("task2"), GENERIC, FLAGS); 								/*Wait for 'task2' sending data in 'hop'*/
 			break;
 		case (1):
 			if (!inputAvailable) exitActivity (1);
 			taskLock();
-			frmcpy (frameT, frameT_, FRAME_LENGTH); 										/*Atomically copy 'frameT' into 'frameT_' to grant consistency*/								
+			sequence = completed;
+			st = (sequence != transformed) ? stftWindow (stream) : ERROR; 					/*Atomically window the current frame, unless already transformed*/
 			taskUnlock();
-			sft (frameT_, frameF, FRAME_LENGTH); 											/*Evaluate the sft of 'frameT' and put results into 'frameF'*/
-			sendToFile (output, frameF, FRAME_LENGTH); 										/*Send results to the output device*/
+			if (st == OK) {
+				missed += sequence - transformed - 1; 										/*Frames committed in the meanwhile are lost*/
+				transformed = sequence;
+			}
+			frame = (st == OK) ? frameAlloc (frames) : NULL; 								/*Nothing to do until the first FRAME_LENGTH samples have been acquired*/
+			if (frame != NULL) {
+				frame->type = SAMPLE_COMPLEX;
+				frame->length = FRAME_LENGTH/2+1;
+				switch (PRECISION) {
+					case (PRECISION_FLOAT):
+						stftTransformFloat (stream, frameF_);
+						complexFromFloat (frameF_, (complex*)frame->samples, FRAME_LENGTH/2+1);
+						break;
+					case (PRECISION_Q15):
+						stftTransformQ15 (stream, frameQ15_);
+						complexFromQ15 (frameQ15_, (complex*)frame->samples, FRAME_LENGTH/2+1, FRAME_LENGTH*FULL_SCALE);
+						break;
+					default:
+						if (FFT_TRANSFORM) { 												/*Evaluate the fft of the windowed frame into 'frame'...*/
+							stftTransform (stream, (complex*)frame->samples);
+							break;
+						}
+						sft (stream->frame, frameS_, FRAME_LENGTH); 						/*...or its algebraic definition (the first FRAME_LENGTH/2+1 bins)*/
+						frmcpy ((double*)frameS_, frame->samples, 2*(FRAME_LENGTH/2+1));
+						break;
+				}
+				if (AVERAGE_FRAMES == 0) sinkSend (spectrumOut, frame); 					/*Send results to the output device...*/
+				else if (averageUpdate (average, (complex*)frame->samples) == OK) { 		/*...or only an average every AVERAGE_FRAMES transforms*/
+					averageRead (average, frame->samples); 									/*The reduced average takes the place of the spectrum*/
+					frame->type = SAMPLE_REAL;
+					sinkSend (spectrumOut, frame);
+				}
+				frameRelease (frame);
+			}
 			break;
 		case (2):
 			if (!inputAvailable) exitActivity (2);
-			if (sendToUDP (UDPSocket, frameT, FRAME_LENGTH) == ERROR) { 					/*Send waveform samples to UDP socket*/
-				perror ("UDP SENDING FAILED");
-			}										
+			if (hop != NULL) {
+				st = sinkSend (sampleOut, hop); 											/*Send waveform samples to UDP socket*/
+				frameRelease (hop);
+				hop = NULL;
+				if (st == ERROR) perror ("UDP SENDING FAILED");
+			}
 			task_signal (GENERIC, FLAGS); 													/*Wake 'task0' after sending data*/
 			break;
 		default:
@@ -137,20 +340,77 @@ void periodicActivity (const int i) {
 
 void initActivity (const int i) {
 
+	STATUS st;
+
 	switch (i) {
 		case (0):
-			input = open (INPUT_FILE, O_RDONLY, 0444); 										/*Open the device waveform comes from*/
+			reader = NULL;
+			mapping = NULL;
+			prefetch = NULL;
+			receiver = NULL;
+			source = NULL;
+			if (UDP_INPUT) { 																/*Frames reassembled from a UDP socket...*/
+				if ((inputSocket = socket (AF_INET, SOCK_DGRAM, 0)) == ERROR) perror ("SOCKET CREATION FAILED");
+				receiver = receiverCreate (inputSocket, INPUT_PORT_NUM, INPUT_WINDOW, INPUT_SLACK, INPUT_TIMEOUT);
+				if (receiver == NULL) perror ("RECEIVER CREATION FAILED");
+				else source = sourceFromUDP (receiver, frames, HOP_LENGTH);
+			}
+			else {
+				input = open (INPUT_FILE, O_RDONLY, 0444); 									/*...or a file: open the device waveform comes from*/
+				if (MAP_INPUT) { 															/*Parsed out of the page cache, by a worker or by blocks*/
+					if ((mapping = mappingCreate (input)) == NULL) perror ("MAPPING CREATION FAILED");
+					else source = sourceFromMapping (mapping, frames, HOP_LENGTH);
+				}
+				else if (PREFETCH_INPUT) {
+					if ((prefetch = prefetchCreate_ (input, HOP_LENGTH, PREFETCH_BUFFERS, IO_PRIO, frames)) == NULL) perror ("PREFETCH CREATION FAILED");
+					else source = sourceFromPrefetch (prefetch);
+				}
+				else if ((reader = readerCreate (input, READER_BLOCK)) == NULL) perror ("READER CREATION FAILED");
+				else source = sourceFromReader (reader, frames, HOP_LENGTH);
+			}
+			if (source == NULL) perror ("SOURCE CREATION FAILED");
 			break;
 		case (1):
-			output = open (OUTPUT_FILE, O_WRONLY, 0644); 									/*Open the device where spectrum has to be sent*/
+			writer = NULL;
+			spectrumSink = NULL;
+			encoder = NULL;
+			spectrumOut = NULL;
+			if (COMPRESSED_OUTPUT) output = open (COMPRESSED_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			else output = open (OUTPUT_FILE, O_WRONLY, 0644); 								/*Open the device where spectrum has to be sent*/
+			if (COMPRESSED_OUTPUT) { 														/*Records of a few hundred bytes, written by 'task1'*/
+				encoder = encoderCreate (output, (AVERAGE_FRAMES == 0) ? SAMPLE_COMPLEX : SAMPLE_REAL, FRAME_LENGTH/2+1, OUTPUT_PRECISION);
+				if (encoder == NULL) perror ("ENCODER CREATION FAILED");
+				else spectrumOut = sinkToEncoder (encoder);
+			}
+			else if (ASYNC_OUTPUT) {
+				spectrumSink = sinkCreate (output, SPECTRUM_SLOTS, (FRAME_LENGTH/2+1)*MAX_LINE_LENGTH, SINK_DROP, IO_PRIO);
+				if (spectrumSink == NULL) perror ("SINK CREATION FAILED");
+				else spectrumOut = sinkToAsync (spectrumSink); 								/*Formatted by 'task1', written by the worker of the sink*/
+			}
+			else if ((writer = writerCreate (output, WRITER_BLOCK)) == NULL) perror ("WRITER CREATION FAILED");
+			else spectrumOut = sinkToWriter (writer);
+			if (spectrumOut == NULL) perror ("SINK CREATION FAILED");
 			break;
 		case (2):
 			if ((UDPSocket = socket (AF_INET, SOCK_DGRAM, 0)) == ERROR) { 					/*Create and UDP socket*/
 				perror ("SOCKET CREATION FAILED");
 			}
-			if (initUDP (UDPSocket, SERVER_IP_ADDRESS, SERVER_PORT_NUM) == ERROR) { 		/*Initialize UDP connection*/
-				perror ("UNKNOWN SERVER NAME");
+			sender = NULL; 																	/*Initialize UDP connection*/
+			sampleSink = NULL;
+			sampleOut = NULL;
+			if (PACKED_UDP) {
+				sender = senderCreate (UDPSocket, SERVER_IP_ADDRESS, SERVER_PORT_NUM);
+				st = (sender != NULL) ? OK : ERROR;
+				if (st == OK) sampleOut = sinkToSender (sender);
+			}
+			else if (ASYNC_OUTPUT) {
+				sampleSink = sinkCreateUDP (UDPSocket, SERVER_IP_ADDRESS, SERVER_PORT_NUM, SAMPLE_SLOTS, MAX_LINE_LENGTH, SINK_DROP, IO_PRIO);
+				st = (sampleSink != NULL) ? OK : ERROR;
+				if (st == OK) sampleOut = sinkToAsync (sampleSink);
 			}
+			else if ((st = initUDP (UDPSocket, SERVER_IP_ADDRESS, SERVER_PORT_NUM)) == OK) sampleOut = sinkToUDP (UDPSocket);
+			if (st == ERROR) perror ("UNKNOWN SERVER NAME");
+			else if (sampleOut == NULL) perror ("SINK CREATION FAILED");
 			break;
 		default:
 			break;
@@ -189,6 +449,30 @@ void init () {
 	/*sysClkRateSet(1000);*/
 	
 	inputAvailable = true;
+	completed = 0;
+	transformed = 0;
+	missed = 0;
+
+	if ((stream = stftCreate_ (FRAME_LENGTH, HOP_LENGTH, WINDOW, PRECISION, FULL_SCALE)) == NULL) { /*Shared by 'task0' and 'task1': created before both*/
+		perror ("STFT CREATION FAILED"); 													/*Its FFT plan included: no task can run without it*/
+		return;
+	}
+	if (!FFT_TRANSFORM && PRECISION != PRECISION_DOUBLE) {
+		perror ("SFT REQUIRES PRECISION_DOUBLE");
+		stftDestroy (stream);
+		return;
+	}
+
+	hop = NULL;
+	poolUsers = 2;
+	if ((frames = poolCreate (POOL_FRAMES, 2*(FRAME_LENGTH/2+1))) == NULL) { 				/*Shared by all the tasks: created before them*/
+		perror ("POOL CREATION FAILED");
+	}
+
+	average = NULL;
+	if (AVERAGE_FRAMES > 0 && (average = averageCreate (FRAME_LENGTH/2+1, AVERAGING, AVERAGE_FRAMES, ALPHA, REDUCTION, 1)) == NULL) {
+		perror ("AVERAGE CREATION FAILED");
+	}
 
 	task_attr_t attr[NT]; 																	/*Tasks' attributes list*/
 	
@@ -204,7 +488,7 @@ void init () {
 				period = 40; 																/*'task0' period*/
 				break;
 			case (1):
-				period = 80; 																/*'task1' period*/
+				period = 40; 																/*'task1' period: one transform for each hop acquired by 'task0'*/
 				break;
 			case (2):
 				period = 40; 																/*'task2' period*/
@@ -0,0 +1,838 @@
+/*
+ * Test 3. Cross-check of the vectorized DSP kernels against the scalar ones: every kernel supported by the running processor evaluates the same transforms and
+ * twiddle multiplications, and results are compared within a tolerance. Transforms whose length isn't a power of 2 (mixed-radix and Bluestein plans) and
+ * the bins tracked by streaming stages (sliding DFT, Goertzel bank) are compared with the algebraic definition, batched transforms with single ones, and
+ * single-precision and Q15 transforms with the double-precision ones within their documented error bounds. Inverse transforms are checked by round trips,
+ * split-complex real transforms are compared with interleaved ones, parallel transforms with single ones, and both are timed on a large frame. Filtering
+ * stages fed in chunks of random length are compared with direct convolutions, averaging stages with direct averages
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* VxWorks libraries */
+
+#include "sysLib.h" 								/*System-dependent library (for sysClkRateGet();)*/
+#include "taskLib.h" 								/*Task library (for taskPriorityGet();)*/
+#include "tickLib.h" 								/*Clock tick library (for tickGet();)*/
+
+/* Generic libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For rand(); utility*/
+
+/* Project libraries */
+
+#include "lib/dsp.h"
+#include "lib/dspKernel.h"
+#include "lib/dspStream.h"
+#include "lib/dspParallel.h"
+#include "lib/dspFilter.h"
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Maximum length of the tested transforms (power of 2) */
+
+#define MAX_LENGTH									4096
+
+/* Lengths which aren't powers of 2: products of 2, 3 and 5 (mixed-radix plans) and lengths with other prime factors (Bluestein plans) */
+
+#define OTHER_LENGTHS								{3, 5, 6, 12, 15, 60, 100, 360, 1000, 1500, 7, 14, 97, 1009, 1023}
+
+/* Window length and bins tracked by the streaming stages, and number of samples they are fed with */
+
+#define STREAM_LENGTH								256
+#define STREAM_BINS									{0, 1, 5, 17, 64, 127, 128, 255}
+#define STREAM_SAMPLES								(16*STREAM_LENGTH)
+
+/* Lengths and numbers of frames of the tested batches (a power of 2 with a partial group of frames, and a length transformed frame by frame) */
+
+#define BATCH_LENGTHS								{256, 120}
+#define BATCH_CHANNELS								{13, 5}
+
+/* Length and number of the contiguous frames of the timed batch, and repetitions of the timed transforms (batched, or frame by frame) */
+
+#define BATCH_TIMED_LENGTH							1024
+#define BATCH_TIMED_CHANNELS						32
+#define BATCH_TIMED_RUNS							1000
+
+/* Maximum absolute difference allowed among results, relative to the length of the transform (rounding errors grow as log2(n) for each bin) */
+
+#define TOLERANCE									1e-12
+
+/* Error bounds of single-precision and Q15 transforms (see dsp.h): relative to the largest bin and to log2(n) the former, in LSB the latter */
+
+#define FLOAT_TOLERANCE								5.96e-8
+#define Q15_TOLERANCE								3
+
+/* Lengths of the parallel transforms compared with single ones (2401 = 49*49 runs Bluestein plans on all the workers at once), number of workers, and
+ * length and repetitions of the timed transforms */
+
+#define PARALLEL_LENGTHS							{97, 1000, 2401, 4096}
+#define PARALLEL_WORKERS							4
+#define TIMED_LENGTH								(1 << 20)
+#define TIMED_RUNS									10
+
+/* Taps of the tested FIR filters, decimation factors, block length of FFT-based convolutions and number of Butterworth sections */
+
+#define FILTER_TAPS									63
+#define FILTER_FACTORS								{2, 4, 5, 8}
+#define FILTER_BLOCK_LENGTH							32
+#define FILTER_SECTIONS								3
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+static double frameT[MAX_LENGTH]; 															/*Random time samples*/
+static complex frameF[MAX_LENGTH]; 															/*Reference results (scalar kernels)*/
+static complex frameF_[MAX_LENGTH]; 														/*Results of the kernels under test*/
+static complex twiddle[MAX_LENGTH]; 														/*Random twiddle factors*/
+static float frameTf[MAX_LENGTH]; 															/*Time samples in single precision...*/
+static q15 frameTq[MAX_LENGTH]; 															/*...and in Q15 format*/
+static complexf frameFf[MAX_LENGTH]; 														/*Results in single precision...*/
+static complexq15 frameFq[MAX_LENGTH]; 														/*...and in Q15 format*/
+static double filtered[2][MAX_LENGTH]; 														/*Outputs of the reference and the tested filters*/
+static double rows[2][4][MAX_LENGTH]; 														/*Rows of batched butterflies (real and imaginary parts of 'a' and 'b'), for the reference and the tested kernels*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Return a random value in [-1, 1] */
+
+double randomValue (void) {
+
+	return 2*((double)rand()/RAND_MAX) - 1;
+
+}
+
+/* Return the maximum absolute difference among 'n' complex values of 'a' and 'b' */
+
+double maxError (const complex * const a, const complex * const b, const unsigned int n) {
+
+	double error = 0;
+
+	unsigned int index;
+	for (index = 0; index < n; index++) {
+		error = fmax (error, fabs (a[index].real - b[index].real));
+		error = fmax (error, fabs (a[index].imag - b[index].imag));
+	}
+
+	return error;
+
+}
+
+/* Compare the transforms evaluated by 'kernel' with the ones evaluated by the scalar kernels, for all lengths up to MAX_LENGTH and for both the complex
+ * and the split-complex layouts */
+
+boolean checkButterfly (const dspKernel * const kernel) {
+
+	const dspKernel * const scalar = kernelGet (SIMD_SCALAR);
+
+	fftPlan *reference, *plan;
+	splitFrame *frameS;
+	double error;
+	boolean passed = true;
+
+	unsigned int n, index;
+	for (n = 1; n <= MAX_LENGTH; n *= 2) {
+		for (index = 0; index < n; index++) frameT[index] = randomValue();
+		reference = fftCreate_ (n, scalar);
+		plan = fftCreate_ (n, kernel);
+		fftExecute (reference, frameT, frameF);
+		fftExecute (plan, frameT, frameF_);
+		error = maxError (frameF, frameF_, n);
+		if (error > TOLERANCE*n) {
+			printf ("%s butterflies: n=%u, error %e. FAILED\n", kernel->name, n, error);
+			passed = false;
+		}
+		frameS = splitCreate (n);
+		fftExecuteSplit (plan, frameT, frameS);
+		complexFromSplit (frameS, frameF_, n);
+		error = maxError (frameF, frameF_, n);
+		if (error > TOLERANCE*n) {
+			printf ("%s split-complex butterflies: n=%u, error %e. FAILED\n", kernel->name, n, error);
+			passed = false;
+		}
+		splitDestroy (frameS);
+		fftDestroy (reference);
+		fftDestroy (plan);
+	}
+
+	return passed;
+
+}
+
+/* Compare the batched butterflies evaluated by 'kernel' with the ones evaluated by the scalar kernels, for 16 rows of every width up to 16 */
+
+boolean checkButterflyBatch (const dspKernel * const kernel) {
+
+	const dspKernel * const scalar = kernelGet (SIMD_SCALAR);
+
+	double error = 0;
+	boolean passed = true;
+
+	unsigned int width, part, index;
+	for (width = 1; width <= 16; width++) { 												/*Every width is tested, to exercise all the remainders*/
+		for (index = 0; index < 16; index++) {
+			twiddle[index].real = randomValue();
+			twiddle[index].imag = randomValue();
+		}
+		for (part = 0; part < 4; part++) {
+			for (index = 0; index < 16*width; index++) {
+				rows[0][part][index] = randomValue();
+				rows[1][part][index] = rows[0][part][index];
+			}
+		}
+		scalar->butterflyBatch (rows[0][0], rows[0][1], rows[0][2], rows[0][3], twiddle, 16, width);
+		kernel->butterflyBatch (rows[1][0], rows[1][1], rows[1][2], rows[1][3], twiddle, 16, width);
+		for (part = 0; part < 4; part++) {
+			for (index = 0; index < 16*width; index++) error = fmax (error, fabs (rows[0][part][index] - rows[1][part][index]));
+		}
+	}
+
+	if (error > TOLERANCE) {
+		printf ("%s batched butterflies: error %e. FAILED\n", kernel->name, error);
+		passed = false;
+	}
+
+	return passed;
+
+}
+
+/* Compare the twiddle multiplications evaluated by 'kernel' with the ones evaluated by the scalar kernels, for all lengths up to MAX_LENGTH/16 */
+
+boolean checkMultiply (const dspKernel * const kernel) {
+
+	const dspKernel * const scalar = kernelGet (SIMD_SCALAR);
+
+	double error;
+	boolean passed = true;
+
+	unsigned int n, index;
+	for (n = 1; n <= MAX_LENGTH/16; n++) { 													/*Every length is tested, to exercise all the remainders*/
+		for (index = 0; index < n; index++) {
+			frameF[index].real = randomValue();
+			frameF[index].imag = randomValue();
+			twiddle[index].real = randomValue();
+			twiddle[index].imag = randomValue();
+			frameF_[index] = frameF[index];
+		}
+		scalar->multiply (frameF, twiddle, n);
+		kernel->multiply (frameF_, twiddle, n);
+		error = maxError (frameF, frameF_, n);
+		if (error > TOLERANCE) {
+			printf ("%s multiplication: n=%u, error %e. FAILED\n", kernel->name, n, error);
+			passed = false;
+		}
+	}
+
+	return passed;
+
+}
+
+/* Compare the FIR filtering evaluated by 'kernel' with the one evaluated by the scalar kernel, for every number of taps up to FILTER_TAPS and every number
+ * of outputs up to 64 (outputs start with random values, since kernels accumulate on them) */
+
+boolean checkFir (const dspKernel * const kernel) {
+
+	const dspKernel * const scalar = kernelGet (SIMD_SCALAR);
+
+	double error = 0;
+
+	unsigned int m, n, index;
+	for (index = 0; index < MAX_LENGTH; index++) frameT[index] = randomValue();
+	for (m = 1; m <= FILTER_TAPS; m++) {
+		for (n = 1; n <= 64; n++) {
+			for (index = 0; index < n; index++) filtered[0][index] = filtered[1][index] = frameT[MAX_LENGTH - 1 - index];
+			scalar->fir (frameT, frameT + MAX_LENGTH/2, m, filtered[0], n);
+			kernel->fir (frameT, frameT + MAX_LENGTH/2, m, filtered[1], n);
+			for (index = 0; index < n; index++) error = fmax (error, fabs (filtered[0][index] - filtered[1][index]));
+		}
+	}
+
+	if (error > TOLERANCE*FILTER_TAPS) {
+		printf ("%s FIR filtering: error %e. FAILED\n", kernel->name, error);
+		return false;
+	}
+
+	return true;
+
+}
+
+/* Compare the transforms of lengths OTHER_LENGTHS with the ones evaluated by sft();, for both the complex and the split-complex layouts. Plans of the same
+ * length must be shared, unless they are Bluestein ones */
+
+boolean checkLengths (void) {
+
+	const unsigned int lengths[] = OTHER_LENGTHS;
+
+	fftPlan *plan, *shared;
+	splitFrame *frameS;
+	double error;
+	boolean passed = true;
+
+	unsigned int i, index;
+	for (i = 0; i < sizeof (lengths)/sizeof (lengths[0]); i++) {
+		for (index = 0; index < lengths[i]; index++) frameT[index] = randomValue();
+		plan = fftCreate (lengths[i]);
+		frameS = splitCreate (lengths[i]);
+		if (plan == NULL || frameS == NULL) {
+			printf ("n=%u: plan creation failed. FAILED\n", lengths[i]);
+			return false;
+		}
+		shared = fftCreate (lengths[i]); 													/*Only Bluestein plans have a copy of their own*/
+		if (shared != NULL && (shared == plan) == (plan->algorithm == FFT_BLUESTEIN)) {
+			printf ("n=%u: plan %s. FAILED\n", lengths[i], (shared == plan) ? "shared" : "not shared");
+			passed = false;
+		}
+		if (shared != NULL) fftDestroy (shared);
+		sft (frameT, frameF, lengths[i]);
+		fftExecute (plan, frameT, frameF_);
+		error = maxError (frameF, frameF_, lengths[i]);
+		fftExecuteSplit (plan, frameT, frameS);
+		complexFromSplit (frameS, frameF_, lengths[i]);
+		error = fmax (error, maxError (frameF, frameF_, lengths[i]));
+		if (error > TOLERANCE*lengths[i]) {
+			printf ("%s transform: n=%u, error %e. FAILED\n", plan->algorithm == FFT_BLUESTEIN ? "Bluestein" : "Mixed-radix", lengths[i], error);
+			passed = false;
+		}
+		splitDestroy (frameS);
+		fftDestroy (plan);
+	}
+
+	return passed;
+
+}
+
+/* Transform random samples forward and back, for every power of 2 up to MAX_LENGTH and for OTHER_LENGTHS, by ifftExecute(); and (for even lengths) by
+ * irfftExecute();, and compare the results with the original samples */
+
+boolean checkInverse (void) {
+
+	const unsigned int others[] = OTHER_LENGTHS;
+
+	fftPlan *plan;
+	rfftPlan *real;
+	unsigned int n;
+	double error;
+	boolean passed = true;
+
+	unsigned int i, index;
+	for (i = 0; i <= log2 (MAX_LENGTH) + sizeof (others)/sizeof (others[0]); i++) {
+		n = (i <= log2 (MAX_LENGTH)) ? 1u << i : others[i - (unsigned int)log2 (MAX_LENGTH) - 1];
+		for (index = 0; index < n; index++) frameT[index] = randomValue();
+		plan = fftCreate (n);
+		fftExecute (plan, frameT, frameF);
+		ifftExecute (plan, frameF, frameF_);
+		error = 0;
+		for (index = 0; index < n; index++) error = fmax (error, fabs (frameF_[index].real - frameT[index]) + fabs (frameF_[index].imag));
+		fftDestroy (plan);
+		if (n % 2 == 0) {
+			real = rfftCreate (n);
+			rfftExecute (real, frameT, frameF);
+			irfftExecute (real, frameF, (double*)frameF_);
+			for (index = 0; index < n; index++) error = fmax (error, fabs (((double*)frameF_)[index] - frameT[index]));
+			rfftDestroy (real);
+		}
+		if (error > TOLERANCE) {
+			printf ("Inverse transform: n=%u, error %e. FAILED\n", n, error);
+			passed = false;
+		}
+	}
+
+	return passed;
+
+}
+
+/* Compare the real transforms evaluated by rfftExecuteSplit(); with the ones of rfftExecute();, for every even power of 2 up to MAX_LENGTH and for the even
+ * OTHER_LENGTHS */
+
+boolean checkRealSplit (void) {
+
+	const unsigned int others[] = OTHER_LENGTHS;
+
+	rfftPlan *real;
+	splitFrame *frameS;
+	unsigned int n;
+	double error;
+	boolean passed = true;
+
+	unsigned int i, index;
+	for (i = 1; i <= log2 (MAX_LENGTH) + sizeof (others)/sizeof (others[0]); i++) {
+		n = (i <= log2 (MAX_LENGTH)) ? 1u << i : others[i - (unsigned int)log2 (MAX_LENGTH) - 1];
+		if (n % 2 == 1) continue;
+		for (index = 0; index < n; index++) frameT[index] = randomValue();
+		real = rfftCreate (n);
+		frameS = splitCreate (n/2 + 1);
+		if (real == NULL || frameS == NULL) {
+			printf ("n=%u: plan creation failed. FAILED\n", n);
+			return false;
+		}
+		rfftExecute (real, frameT, frameF);
+		rfftExecuteSplit (real, frameT, frameS);
+		complexFromSplit (frameS, frameF_, n/2 + 1);
+		error = maxError (frameF, frameF_, n/2 + 1);
+		if (error > TOLERANCE*n) {
+			printf ("Split-complex real transform: n=%u, error %e. FAILED\n", n, error);
+			passed = false;
+		}
+		splitDestroy (frameS);
+		rfftDestroy (real);
+	}
+
+	return passed;
+
+}
+
+/* Feed the streaming stages with random samples, in chunks of random length, and compare their bins with the ones evaluated by sft(); on the last window
+ * (sliding DFT) or on the last complete block (Goertzel bank) */
+
+boolean checkStreaming (void) {
+
+	const unsigned int bins[] = STREAM_BINS;
+	const unsigned int count = sizeof (bins)/sizeof (bins[0]);
+
+	sdft *sliding = sdftCreate (STREAM_LENGTH, bins, count);
+	goertzel *block = goertzelCreate (STREAM_LENGTH, bins, count);
+	double error = 0;
+	boolean passed = true;
+
+	unsigned int t, chunk, i;
+
+	if (sliding == NULL || block == NULL) {
+		printf ("Streaming stages creation failed. FAILED\n");
+		return false;
+	}
+
+	for (t = 0; t < STREAM_SAMPLES; t += chunk) {
+		chunk = 1 + rand() % 32;
+		if (chunk > STREAM_LENGTH - t % STREAM_LENGTH) chunk = STREAM_LENGTH - t % STREAM_LENGTH; 	/*Chunks never cross a block, so that 'frameT' holds it*/
+		for (i = 0; i < chunk; i++) frameT[t % STREAM_LENGTH + i] = randomValue();
+		sdftUpdate (sliding, frameT + t % STREAM_LENGTH, chunk);
+		if (goertzelUpdate (block, frameT + t % STREAM_LENGTH, chunk) == OK) { 				/*'frameT' holds both the last window and the last block*/
+			sft (frameT, frameF, STREAM_LENGTH);
+			sdftRead (sliding, frameF_);
+			for (i = 0; i < count; i++) error = fmax (error, maxError (&frameF[bins[i]], &frameF_[i], 1));
+			goertzelRead (block, frameF_);
+			for (i = 0; i < count; i++) error = fmax (error, maxError (&frameF[bins[i]], &frameF_[i], 1));
+		}
+	}
+
+	if (error > TOLERANCE*STREAM_LENGTH) {
+		printf ("Streaming stages: error %e. FAILED\n", error);
+		passed = false;
+	}
+
+	sdftDestroy (sliding);
+	goertzelDestroy (block);
+
+	return passed;
+
+}
+
+/* Feed the averaging stages with random spectra of STREAM_LENGTH bins, and compare their outputs with the power of the same bins averaged directly (Welch
+ * averaging, in dB) or by the exponential recursion (in magnitude) */
+
+boolean checkAverage (void) {
+
+	const unsigned int frames = 4;
+	const double alpha = 0.25;
+
+	spectrumAverage *welch = averageCreate (STREAM_LENGTH, AVERAGING_WELCH, frames, 0, REDUCTION_DB, 1);
+	spectrumAverage *exponential = averageCreate (STREAM_LENGTH, AVERAGING_EXPONENTIAL, frames, alpha, REDUCTION_MAGNITUDE, 1);
+	double power, error = 0;
+	STATUS st;
+
+	unsigned int f, k;
+
+	if (welch == NULL || exponential == NULL) {
+		printf ("Averaging stages creation failed. FAILED\n");
+		return false;
+	}
+
+	for (k = 0; k < STREAM_LENGTH; k++) rows[0][0][k] = rows[0][1][k] = 0; 					/*Welch sums and exponential averages*/
+
+	for (f = 1; f <= 4*frames; f++) {
+		for (k = 0; k < STREAM_LENGTH; k++) {
+			frameF[k].real = randomValue();
+			frameF[k].imag = randomValue();
+			power = frameF[k].real*frameF[k].real + frameF[k].imag*frameF[k].imag;
+			rows[0][0][k] += power;
+			rows[0][1][k] = (f == 1) ? power : (1 - alpha)*rows[0][1][k] + alpha*power;
+		}
+		st = averageUpdate (welch, frameF);
+		if ((st == OK) != (f % frames == 0) || (averageUpdate (exponential, frameF) == OK) != (f % frames == 0)) {
+			printf ("Averaging stages: output after %u spectra. FAILED\n", f);
+			return false;
+		}
+		if (st != OK) continue;
+		averageRead (welch, rows[1][0]);
+		averageRead (exponential, rows[1][1]);
+		for (k = 0; k < STREAM_LENGTH; k++) {
+			error = fmax (error, fabs (rows[1][0][k] - 10*log10(rows[0][0][k]/frames)));
+			error = fmax (error, fabs (rows[1][1][k] - sqrt(rows[0][1][k])));
+			rows[0][0][k] = 0;
+		}
+	}
+
+	averageDestroy (welch);
+	averageDestroy (exponential);
+
+	if (error > TOLERANCE) {
+		printf ("Averaging stages: error %e. FAILED\n", error);
+		return false;
+	}
+
+	return true;
+
+}
+
+/* Return the average time (ms) of BATCH_TIMED_RUNS transforms of the contiguous frames of 'batch' in 'frameT': by 'batch', or frame by frame by 'real'
+ * or (if 'real' is NULL) by 'plan', if they aren't NULL. 'frameF' must have room for the 'n' bins of every frame */
+
+double timeBatch (const fftBatch * const batch, const rfftPlan * const real, const fftPlan * const plan, const double * const frameT,
+	complex * const frameF) {
+
+	const ULONG start = tickGet();
+
+	unsigned int run, c;
+	for (run = 0; run < BATCH_TIMED_RUNS; run++) {
+		if (real == NULL && plan == NULL) fftBatchExecute (batch, frameT, 1, batch->n, frameF);
+		else for (c = 0; c < batch->channels; c++) {
+			if (real != NULL) rfftExecute (real, &frameT[c*batch->n], &frameF[c*batch->n]);
+			else fftExecute (plan, &frameT[c*batch->n], &frameF[c*batch->n]);
+		}
+	}
+
+	return ((tickGet() - start)*1000.0)/(sysClkRateGet()*BATCH_TIMED_RUNS);
+
+}
+
+/* Compare the batched transforms of BATCH_LENGTHS with the ones evaluated frame by frame by rfftExecute();, for both contiguous and interleaved frames,
+ * then time a batch of BATCH_TIMED_CHANNELS frames against as many calls of rfftExecute(); and of fftExecute(); */
+
+boolean checkBatch (void) {
+
+	const unsigned int lengths[] = BATCH_LENGTHS;
+	const unsigned int channels[] = BATCH_CHANNELS;
+
+	fftBatch *batch;
+	rfftPlan *plan;
+	fftPlan *complexPlan;
+	double *samples;
+	complex *spectra;
+	double error = 0;
+	double elapsed[3];
+	boolean passed = true;
+
+	unsigned int i, interleaved, c, index, bins;
+	for (i = 0; i < sizeof (lengths)/sizeof (lengths[0]); i++) {
+		batch = fftBatchCreate (lengths[i], channels[i]);
+		plan = rfftCreate (lengths[i]);
+		if (batch == NULL || plan == NULL) {
+			printf ("n=%u: batch creation failed. FAILED\n", lengths[i]);
+			return false;
+		}
+		bins = lengths[i]/2 + 1;
+		for (index = 0; index < lengths[i]*channels[i]; index++) frameT[index] = randomValue();
+		for (interleaved = 0; interleaved < 2; interleaved++) {
+			if (interleaved) fftBatchExecute (batch, frameT, channels[i], 1, frameF_);
+			else fftBatchExecute (batch, frameT, 1, lengths[i], frameF_);
+			for (c = 0; c < channels[i]; c++) {
+				for (index = 0; index < lengths[i]; index++) { 								/*Frame 'c' is rebuilt contiguously at the end of 'frameT'*/
+					frameT[MAX_LENGTH - lengths[i] + index] = interleaved ? frameT[index*channels[i] + c] : frameT[c*lengths[i] + index];
+				}
+				rfftExecute (plan, &frameT[MAX_LENGTH - lengths[i]], frameF);
+				error = fmax (error, maxError (frameF, &frameF_[c*bins], bins));
+			}
+		}
+		if (error > TOLERANCE*lengths[i]) {
+			printf ("Batched transform: n=%u, error %e. FAILED\n", lengths[i], error);
+			passed = false;
+		}
+		fftBatchDestroy (batch);
+		rfftDestroy (plan);
+	}
+
+	samples = (double*)malloc (BATCH_TIMED_LENGTH*BATCH_TIMED_CHANNELS*sizeof (double));
+	spectra = (complex*)malloc (BATCH_TIMED_LENGTH*BATCH_TIMED_CHANNELS*sizeof (complex));
+	batch = fftBatchCreate (BATCH_TIMED_LENGTH, BATCH_TIMED_CHANNELS);
+	plan = rfftCreate (BATCH_TIMED_LENGTH);
+	complexPlan = fftCreate (BATCH_TIMED_LENGTH);
+	if (samples == NULL || spectra == NULL || batch == NULL || plan == NULL || complexPlan == NULL) {
+		printf ("n=%u: timed batch creation failed. Skipped\n", BATCH_TIMED_LENGTH);
+	}
+	else {
+		for (index = 0; index < BATCH_TIMED_LENGTH*BATCH_TIMED_CHANNELS; index++) samples[index] = randomValue();
+		elapsed[0] = timeBatch (batch, NULL, NULL, samples, spectra);
+		elapsed[1] = timeBatch (batch, plan, NULL, samples, spectra);
+		elapsed[2] = timeBatch (batch, NULL, complexPlan, samples, spectra);
+		printf ("n=%u, %u frames: batched %.3f ms, rfftExecute %.3f ms (%.2fx), fftExecute %.3f ms (%.2fx)\n", BATCH_TIMED_LENGTH, BATCH_TIMED_CHANNELS,
+			elapsed[0], elapsed[1], elapsed[1]/elapsed[0], elapsed[2], elapsed[2]/elapsed[0]);
+	}
+	if (batch != NULL) fftBatchDestroy (batch);
+	if (plan != NULL) rfftDestroy (plan);
+	if (complexPlan != NULL) fftDestroy (complexPlan);
+	free (samples);
+	free (spectra);
+
+	return passed;
+
+}
+
+/* Compare the single-precision and Q15 real transforms of every length up to MAX_LENGTH with the double-precision ones, evaluated on the same (rounded)
+ * samples */
+
+boolean checkPrecision (void) {
+
+	rfftPlan *plan;
+	double error, peak;
+	boolean passed = true;
+
+	unsigned int n, stages, index;
+	for (n = 2, stages = 1; n <= MAX_LENGTH; n *= 2, stages++) {
+		plan = rfftCreate (n);
+		for (index = 0; index < n; index++) frameTf[index] = (float)randomValue();
+		for (index = 0; index < n; index++) frameT[index] = frameTf[index];
+		rfftExecute (plan, frameT, frameF);
+		rfftExecuteFloat (plan, frameTf, frameFf);
+		complexFromFloat (frameFf, frameF_, n/2 + 1);
+		peak = 0;
+		for (index = 0; index <= n/2; index++) peak = fmax (peak, hypot (frameF[index].real, frameF[index].imag));
+		error = maxError (frameF, frameF_, n/2 + 1);
+		if (error > FLOAT_TOLERANCE*stages*peak) {
+			printf ("Single-precision transform: n=%u, error %e. FAILED\n", n, error);
+			passed = false;
+		}
+		q15FromReal (frameT, frameTq, n, 1);
+		for (index = 0; index < n; index++) frameT[index] = frameTq[index]/32768.0;
+		rfftExecute (plan, frameT, frameF);
+		rfftExecuteQ15 (plan, frameTq, frameFq);
+		complexFromQ15 (frameFq, frameF_, n/2 + 1, n); 										/*Compared with X[k], errors are 'n' times the ones of X[k]/n*/
+		error = maxError (frameF, frameF_, n/2 + 1)/n*32768;
+		if (error > Q15_TOLERANCE) {
+			printf ("Q15 transform: n=%u, error %.2f LSB. FAILED\n", n, error);
+			passed = false;
+		}
+		rfftDestroy (plan);
+	}
+
+	return passed;
+
+}
+
+/* Return the average time (ms) of TIMED_RUNS transforms of 'frameT' by 'engine', or by 'plan' if 'engine' is NULL */
+
+double timeTransform (fftParallel * const engine, const fftPlan * const plan, const double * const frameT, complex * const frameF) {
+
+	const ULONG start = tickGet();
+
+	unsigned int run;
+	for (run = 0; run < TIMED_RUNS; run++) {
+		if (engine != NULL) fftParallelExecute (engine, frameT, frameF);
+		else fftExecute (plan, frameT, frameF);
+	}
+
+	return ((tickGet() - start)*1000.0)/(sysClkRateGet()*TIMED_RUNS);
+
+}
+
+/* Compare the parallel transforms of PARALLEL_LENGTHS, with 1 and PARALLEL_WORKERS workers, with the ones evaluated by fftExecute();, then time both on a
+ * frame of TIMED_LENGTH samples */
+
+boolean checkParallel (void) {
+
+	const unsigned int lengths[] = PARALLEL_LENGTHS;
+	const unsigned int workers[] = {1, PARALLEL_WORKERS};
+
+	fftParallel *engine;
+	fftPlan *plan;
+	double *samples;
+	complex *bins;
+	double error, single, parallel[2];
+	int priority;
+	boolean passed = true;
+
+	unsigned int i, w, index;
+
+	taskPriorityGet (taskIdSelf(), &priority); 												/*Workers compete for the processor with the calling task*/
+
+	for (i = 0; i < sizeof (lengths)/sizeof (lengths[0]); i++) {
+		for (index = 0; index < lengths[i]; index++) frameT[index] = randomValue();
+		plan = fftCreate (lengths[i]);
+		fftExecute (plan, frameT, frameF);
+		for (w = 0; w < 2; w++) {
+			engine = fftParallelCreate (lengths[i], workers[w], priority);
+			if (engine == NULL) {
+				printf ("n=%u: parallel transform creation failed. FAILED\n", lengths[i]);
+				return false;
+			}
+			fftParallelExecute (engine, frameT, frameF_);
+			error = maxError (frameF, frameF_, lengths[i]);
+			if (error > TOLERANCE*lengths[i]) {
+				printf ("Parallel transform: n=%u, %u workers, error %e. FAILED\n", lengths[i], workers[w], error);
+				passed = false;
+			}
+			fftParallelDestroy (engine);
+		}
+		fftDestroy (plan);
+	}
+
+	samples = (double*)malloc (TIMED_LENGTH*sizeof (double));
+	bins = (complex*)malloc (TIMED_LENGTH*sizeof (complex));
+	plan = fftCreate (TIMED_LENGTH);
+	if (samples == NULL || bins == NULL || plan == NULL) {
+		printf ("n=%u: timed transform creation failed. Skipped\n", TIMED_LENGTH);
+	}
+	else {
+		for (index = 0; index < TIMED_LENGTH; index++) samples[index] = randomValue();
+		single = timeTransform (NULL, plan, samples, bins);
+		for (w = 0; w < 2; w++) {
+			engine = fftParallelCreate (TIMED_LENGTH, workers[w], priority);
+			parallel[w] = (engine != NULL) ? timeTransform (engine, NULL, samples, bins) : 0;
+			if (engine != NULL) fftParallelDestroy (engine);
+		}
+		printf ("n=%u: single %.1f ms, parallel %.1f ms with 1 worker, %.1f ms with %u workers\n", TIMED_LENGTH, single, parallel[0], parallel[1],
+			PARALLEL_WORKERS);
+	}
+	if (plan != NULL) fftDestroy (plan);
+	free (samples);
+	free (bins);
+
+	return passed;
+
+}
+
+/* Feed the filtering stages with MAX_LENGTH random samples, in chunks of random length: FIR, decimators and FFT-based convolutions (fed with multiples of
+ * their block) are compared with the direct convolution of the whole input, biquads with the same cascade fed in a single call */
+
+boolean checkFilters (void) {
+
+	const unsigned int factors[] = FILTER_FACTORS;
+
+	double h[FILTER_TAPS], coefficients[5*FILTER_SECTIONS];
+	firFilter *fir;
+	decimator *decimate;
+	convolver *convolve;
+	biquadCascade *single, *chunked;
+	double error = 0;
+	unsigned int outputs;
+	boolean passed = true;
+
+	unsigned int t, chunk, index, j, i;
+
+	for (index = 0; index < MAX_LENGTH; index++) frameT[index] = randomValue();
+	firLowpass (h, FILTER_TAPS, 0.1);
+	for (t = 0; t < MAX_LENGTH; t++) { 														/*Direct convolution, with zeros before the first sample*/
+		filtered[0][t] = 0;
+		for (j = 0; j < FILTER_TAPS && j <= t; j++) filtered[0][t] += h[j]*frameT[t - j];
+	}
+
+	fir = firCreate (h, FILTER_TAPS);
+	for (t = 0; t < MAX_LENGTH; t += chunk) {
+		chunk = 1 + rand() % 600;
+		if (chunk > MAX_LENGTH - t) chunk = MAX_LENGTH - t;
+		firExecute (fir, frameT + t, filtered[1] + t, chunk);
+	}
+	for (t = 0; t < MAX_LENGTH; t++) error = fmax (error, fabs (filtered[0][t] - filtered[1][t]));
+	firDestroy (fir);
+
+	for (i = 0; i < sizeof (factors)/sizeof (factors[0]); i++) {
+		decimate = decimatorCreate (h, FILTER_TAPS, factors[i]);
+		outputs = 0;
+		for (t = 0; t < MAX_LENGTH; t += chunk) {
+			chunk = 1 + rand() % 600;
+			if (chunk > MAX_LENGTH - t) chunk = MAX_LENGTH - t;
+			outputs += decimatorExecute (decimate, frameT + t, filtered[1] + outputs, chunk);
+		}
+		if (outputs != (MAX_LENGTH + factors[i] - 1)/factors[i]) {
+			printf ("Decimation by %u: %u outputs. FAILED\n", factors[i], outputs);
+			passed = false;
+		}
+		for (t = 0; t < outputs; t++) error = fmax (error, fabs (filtered[0][t*factors[i]] - filtered[1][t]));
+		decimatorDestroy (decimate);
+	}
+
+	for (i = 0; i < 2; i++) {
+		convolve = convolverCreate (h, FILTER_TAPS, FILTER_BLOCK_LENGTH, (convolutionMethod)i);
+		for (t = 0; t < MAX_LENGTH; t += chunk) {
+			chunk = FILTER_BLOCK_LENGTH*(1 + rand() % 8);
+			if (chunk > MAX_LENGTH - t) chunk = MAX_LENGTH - t;
+			convolverExecute (convolve, frameT + t, filtered[1] + t, chunk);
+		}
+		for (t = 0; t < MAX_LENGTH; t++) error = fmax (error, fabs (filtered[0][t] - filtered[1][t]));
+		convolverDestroy (convolve);
+	}
+
+	biquadLowpass (coefficients, FILTER_SECTIONS, 0.1);
+	single = biquadCreate (coefficients, FILTER_SECTIONS);
+	chunked = biquadCreate (coefficients, FILTER_SECTIONS);
+	biquadExecute (single, frameT, filtered[0], MAX_LENGTH);
+	for (t = 0; t < MAX_LENGTH; t += chunk) {
+		chunk = 1 + rand() % 600;
+		if (chunk > MAX_LENGTH - t) chunk = MAX_LENGTH - t;
+		for (index = 0; index < chunk; index++) filtered[1][t + index] = frameT[t + index];
+		biquadExecute (chunked, filtered[1] + t, filtered[1] + t, chunk); 					/*In place*/
+	}
+	for (t = 0; t < MAX_LENGTH; t++) error = fmax (error, fabs (filtered[0][t] - filtered[1][t]));
+	biquadDestroy (single);
+	biquadDestroy (chunked);
+
+	if (error > TOLERANCE*FILTER_TAPS) {
+		printf ("Filtering stages: error %e. FAILED\n", error);
+		passed = false;
+	}
+
+	return passed;
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Init VxWorks function */
+
+void init () {
+
+	const dspKernel *kernel;
+	boolean passed;
+
+	unsigned int isa;
+	for (isa = SIMD_SCALAR + 1; isa < SIMD_COUNT; isa++) {
+		kernel = kernelGet ((simd)isa);
+		if (kernel == NULL) {
+			printf ("Kernel %u not supported by this processor: skipped.\n", isa);
+			continue;
+		}
+		passed = checkButterfly (kernel);
+		passed = checkButterflyBatch (kernel) && passed;
+		passed = checkMultiply (kernel) && passed;
+		passed = checkFir (kernel) && passed;
+		printf ("%s kernels: %s\n", kernel->name, passed ? "PASSED" : "FAILED");
+	}
+
+	printf ("Selected kernels: %s\n", kernelSelect()->name);
+
+	printf ("Other lengths: %s\n", checkLengths() ? "PASSED" : "FAILED");
+
+	printf ("Inverse transforms: %s\n", checkInverse() ? "PASSED" : "FAILED");
+
+	printf ("Split-complex real transforms: %s\n", checkRealSplit() ? "PASSED" : "FAILED");
+
+	printf ("Streaming stages: %s\n", checkStreaming() ? "PASSED" : "FAILED");
+
+	printf ("Averaging stages: %s\n", checkAverage() ? "PASSED" : "FAILED");
+
+	printf ("Batched transforms: %s\n", checkBatch() ? "PASSED" : "FAILED");
+
+	printf ("Single-precision and Q15 transforms: %s\n", checkPrecision() ? "PASSED" : "FAILED");
+
+	printf ("Parallel transforms: %s\n", checkParallel() ? "PASSED" : "FAILED");
+
+	printf ("Filtering stages: %s\n", checkFilters() ? "PASSED" : "FAILED");
+
+}
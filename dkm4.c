@@ -0,0 +1,1094 @@
+/*
+ * Test 4. Checks and benchmarks of the I/O functions: the parser of acquired samples is checked on well-formed and malformed lines, and its throughput
+ * is compared with the one of atof(); on the lines of the input file. Frames acquired through a file mapping are compared with the ones acquired by a
+ * buffered reader, and frames written to a binary file with the ones read back. The fixed-point formatter is compared with sprintf();, and the text of
+ * spectra sent by a buffered writer with the one sent by sendToFile();. UDP frames are sent to a loopback receiver, which checks their order, losses and
+ * content, and through a relay which reorders and drops datagrams to a UDP acquisition source, whose frames and counters are checked. Asynchronous sinks
+ * are checked against the buffered writer, with both policies, and on datagrams sent to a loopback receiver. Frames taken from a prefetching source are
+ * compared with the ones acquired by a buffered reader, and so are the frames of a frame source, which are handed between stages by reference and written
+ * by a frame sink. Spectra of the input file are compressed at several precisions: the throughput of the encoder and of the decoder and the compression
+ * ratio are printed, and decoded spectra must be within the precision of the sent ones. The files written by the checks are removed at the end
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* VxWorks libraries */
+
+#include "ioLib.h" 									/*I/O interface library*/
+#include "sockLib.h" 								/*Generic socket library*/
+#include "inetLib.h" 								/*Internet address manipulation routines*/
+#include "sysLib.h" 								/*System-dependent library (for sysClkRateGet();)*/
+#include "tickLib.h" 								/*Clock tick library (for tickGet();)*/
+
+/* Generic libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For atof();, malloc(); and free(); utilities*/
+#include "string.h" 								/*For memchr();, memcmp();, memset(); and strcmp(); utilities*/
+
+/* Project libraries */
+
+#include "lib/dspIO.h"
+#include "lib/dspAsync.h"
+#include "lib/dspFrame.h"
+#include "lib/dspStream.h"
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Input file, and maximum number of its lines which are loaded */
+
+#define INPUT_FILE 									"wave.txt"
+#define BINARY_FILE 								"wave.bin"
+#define OUTPUT_FILES 								{"spectrum1.txt", "spectrum2.txt"}
+#define MAX_LINES									(1 << 18)
+
+/* Samples acquired at once from the input file (not a divisor of its lines, so that the last frame is incomplete) */
+
+#define FRAME_LENGTH								300
+
+/* Random values formatted by formatFixed(); and sprintf();, and bins and number of the spectra sent to the output files */
+
+#define FORMAT_VALUES								1000000
+#define SPECTRUM_BINS								129
+#define SPECTRUM_FRAMES								200
+
+/* Reduced values (beyond the range of complex lines) written by sendRealToFile();, and the text expected (the last one is beyond FORMAT_LIMIT) */
+
+#define REDUCED_VALUES								{12345.6789, -987654.321, 2e12}
+#define REDUCED_TEXT								"+12345.6789\n-987654.3210\nNaN\n"
+
+/* Loopback address and port of the receiver of UDP frames (the next port has no receiver), and length and number of the frames sent */
+
+#define LOOPBACK_ADDRESS 							"127.0.0.1"
+#define LOOPBACK_PORT 								5003
+#define UDP_LENGTH									1000
+#define UDP_FRAMES									100
+
+/* Window and slack of the UDP acquisition source (samples), its timeout (ms), and frames whose datagrams are swapped or dropped by the relay */
+
+#define UDP_WINDOW									4096
+#define UDP_SLACK									(2*DATAGRAM_SAMPLES)
+#define UDP_TIMEOUT									200
+#define SWAPPED_FRAME								3
+#define DROPPED_FRAME								7
+
+/* Slots of the asynchronous sinks (few of them, so that the ring fills up), and priority of their workers */
+
+#define SINK_SLOTS 									4
+#define SAMPLE_SLOTS 								256
+#define SINK_PRIO 									200
+
+/* Frames of the pool of the prefetching source */
+
+#define PREFETCH_BUFFERS 							4
+
+/* Frames of the pool of frame sources and sinks */
+
+#define POOL_FRAMES 								3
+
+/* Compressed output: spectra of the input file (transform length and hop of Test 2) and quantization steps, the first one keeping the decimals of the
+ * text output */
+
+#define CODEC_FRAME 								256
+#define CODEC_HOP 									64
+#define CODEC_PRECISIONS 							{0.0001, 0.01}
+
+/* Repetitions of the timed loops */
+
+#define BENCHMARK_RUNS								20
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Line given to the parser, with the expected status and value */
+
+typedef struct parserCase {
+
+	const char *text;
+	STATUS status;
+	double value;
+
+} parserCase;
+
+static const parserCase cases[] = {
+	{"+0.0000", OK, 0}, {"-10.6887", OK, -10.6887}, {"+999.9999\n", OK, 999.9999}, {"  3.25\r", OK, 3.25}, {"7", OK, 7}, {".5", OK, 0.5},
+	{"-0.", OK, 0}, {"000000000000000000001.5", OK, 1.5}, {"0.123456789012345", OK, 0.123456789012345}, {"", MALFORMED_SAMPLE, 0},
+	{"+", MALFORMED_SAMPLE, 0}, {"-.", MALFORMED_SAMPLE, 0}, {"1.2.3", MALFORMED_SAMPLE, 0}, {"12a", MALFORMED_SAMPLE, 0},
+	{"1e5", MALFORMED_SAMPLE, 0}, {"--1", MALFORMED_SAMPLE, 0}, {"1,5", MALFORMED_SAMPLE, 0}, {"1234567890123456789", MALFORMED_SAMPLE, 0}
+};
+
+static char *text; 																			/*Content of the input file*/
+static unsigned int size; 																	/*Characters of 'text'*/
+static char *lines[MAX_LINES]; 																/*First character of each line of 'text'*/
+static unsigned int count; 																	/*Lines of 'text'*/
+static double values[2][MAX_LINES]; 														/*Values parsed by atof(); and by parseFixed();*/
+static char relayed[UDP_BATCH][UDP_PAYLOAD]; 												/*Datagrams of a frame held by the relay*/
+static double *spectra[2]; 																	/*Spectra of the input file: complex bins and their levels (dB)*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Load the content of INPUT_FILE into 'text', and split it into 'lines' */
+
+STATUS loadInput (void) {
+
+	int input;
+	int len;
+	char *grown;
+	char *line;
+
+	if ((input = open (INPUT_FILE, O_RDONLY, 0444)) == ERROR) return ERROR;
+
+	size = 0;
+	text = NULL;
+	do {
+		if ((grown = (char*)realloc (text, size + READER_BLOCK + 1)) == NULL) break;
+		text = grown;
+		len = read (input, text + size, READER_BLOCK);
+		if (len > 0) size += (unsigned int)len;
+	} while (len > 0);
+
+	close (input);
+
+	if (grown == NULL) {
+		free (text);
+		return ERROR;
+	}
+
+	text[size] = '\0';
+	count = 0;
+	line = text;
+	while (line < text + size && count < MAX_LINES) {
+		lines[count++] = line;
+		if ((line = (char*)memchr (line, '\n', text + size - line)) == NULL) break;
+		line++; 																			/*The next line starts after the newline character*/
+	}
+
+	return OK;
+
+}
+
+/* Return the milliseconds spent by BENCHMARK_RUNS conversions of all the loaded lines, by atof(); or parseFixed(); */
+
+double timeParser (const boolean fixed) {
+
+	const ULONG start = tickGet();
+
+	unsigned int run, i;
+	for (run = 0; run < BENCHMARK_RUNS; run++) {
+		if (fixed) for (i = 0; i < count; i++) parseFixed (lines[i], &values[1][i]);
+		else for (i = 0; i < count; i++) values[0][i] = atof (lines[i]);
+	}
+
+	return ((tickGet() - start)*1000.0)/sysClkRateGet();
+
+}
+
+/* Parse the lines of 'cases' and compare status and value with the expected ones */
+
+boolean checkParser (void) {
+
+	double value;
+	STATUS st;
+	boolean passed = true;
+
+	unsigned int i;
+	for (i = 0; i < sizeof (cases)/sizeof (cases[0]); i++) {
+		st = parseFixed (cases[i].text, &value);
+		if (st != cases[i].status || value != cases[i].value) {
+			printf ("Parser: '%s' gives 0x%08x and %f. FAILED\n", cases[i].text, (unsigned int)st, value);
+			passed = false;
+		}
+	}
+
+	st = parseFixed ("NaN", &value);
+	if (st != OK || !isnan (value)) {
+		printf ("Parser: 'NaN' gives 0x%08x and %f. FAILED\n", (unsigned int)st, value);
+		passed = false;
+	}
+
+	return passed;
+
+}
+
+/* Parse the lines of INPUT_FILE by atof(); and parseFixed();, compare the results and print the throughput of both */
+
+boolean benchmarkParser (void) {
+
+	double reference, fixed;
+	boolean passed = true;
+
+	unsigned int i;
+
+	if (loadInput() == ERROR) {
+		printf ("Parser benchmark: %s not available. FAILED\n", INPUT_FILE);
+		return false;
+	}
+
+	reference = timeParser (false);
+	fixed = timeParser (true);
+
+	for (i = 0; i < count; i++) {
+		if (values[0][i] != values[1][i]) {
+			printf ("Parser: line %u gives %f instead of %f. FAILED\n", i + 1, values[1][i], values[0][i]);
+			passed = false;
+			break;
+		}
+	}
+
+	printf ("%u lines, %u characters: atof %.1f MB/s, parseFixed %.1f MB/s\n", count, size, (size*BENCHMARK_RUNS)/(1000*fmax (reference, 1e-3)),
+		(size*BENCHMARK_RUNS)/(1000*fmax (fixed, 1e-3)));
+
+	free (text);
+
+	return passed;
+
+}
+
+/* Acquire FRAME_LENGTH samples at a time from INPUT_FILE, by a buffered reader ('mapped' false) or by a file mapping, into 'values[mapped]' until the end
+ * of file. The number of complete frames is written in 'frames', and the milliseconds spent are returned (a negative value if the source isn't available) */
+
+double acquireInput (const boolean mapped, unsigned int * const frames) {
+
+	fileReader *reader = NULL;
+	fileMapping *mapping = NULL;
+	int input;
+	ULONG start;
+	STATUS st;
+
+	*frames = 0;
+
+	if ((input = open (INPUT_FILE, O_RDONLY, 0444)) == ERROR) return -1;
+	if (mapped) mapping = mappingCreate (input);
+	else reader = readerCreate (input, READER_BLOCK);
+	if (mapping == NULL && reader == NULL) {
+		close (input);
+		return -1;
+	}
+
+	start = tickGet();
+	do {
+		if (mapped) st = acquireFromMapping (mapping, values[1] + *frames*FRAME_LENGTH, FRAME_LENGTH);
+		else st = acquireFromReader (reader, values[0] + *frames*FRAME_LENGTH, FRAME_LENGTH);
+		if (st != EOF_REACHED) (*frames)++;
+	} while (st != EOF_REACHED && (*frames + 1)*FRAME_LENGTH <= MAX_LINES);
+
+	start = tickGet() - start;
+
+	if (mapped) mappingDestroy (mapping);
+	else readerDestroy (reader);
+	close (input);
+
+	return (start*1000.0)/sysClkRateGet();
+
+}
+
+/* Acquire INPUT_FILE by a buffered reader and by a file mapping: the same frames must be acquired before the end of file */
+
+boolean checkMapping (void) {
+
+	unsigned int frames[2];
+	double elapsed[2];
+
+	unsigned int i;
+
+	elapsed[0] = acquireInput (false, &frames[0]);
+	elapsed[1] = acquireInput (true, &frames[1]);
+
+	if (elapsed[0] < 0 || elapsed[1] < 0) {
+		printf ("Mapped input: %s not available. FAILED\n", INPUT_FILE);
+		return false;
+	}
+
+	printf ("%u frames of %u samples: reader %.1f ms, mapping %.1f ms\n", frames[0], FRAME_LENGTH, elapsed[0], elapsed[1]);
+
+	if (frames[0] != frames[1]) return false;
+	for (i = 0; i < frames[0]*FRAME_LENGTH; i++) {
+		if (values[0][i] != values[1][i]) return false;
+	}
+
+	return true;
+
+}
+
+/* Write the frames of INPUT_FILE to BINARY_FILE, read them back and compare them (header included). The time spent reading them is printed. Headers of
+ * frames too large (2^32 doubles), or larger than the file, must be rejected */
+
+boolean checkBinary (void) {
+
+	binaryHeader header = {SAMPLE_REAL, FRAME_LENGTH, 8000, 1};
+	binaryHeader forged[2] = {{SAMPLE_COMPLEX, 0x10000, 8000, 0x8000}, {SAMPLE_REAL, FRAME_LENGTH, 8000, 1}};
+	binaryHeader header_;
+	unsigned int frames;
+	int file;
+	ULONG start;
+	boolean passed = true;
+
+	unsigned int f, i;
+
+	if (acquireInput (false, &frames) < 0) return false;
+
+	if ((file = open (BINARY_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+	if (sendHeaderToFile (file, &header) != OK) passed = false;
+	for (f = 0; f < frames; f++) {
+		if (sendBinaryToFile (file, values[0] + f*FRAME_LENGTH, FRAME_LENGTH) != OK) passed = false;
+	}
+	close (file);
+
+	if ((file = open (BINARY_FILE, O_RDONLY, 0444)) == ERROR) return false;
+	start = tickGet();
+	if (acquireHeaderFromFile (file, &header_) != OK) {
+		close (file);
+		return false;
+	}
+	for (f = 0; f < frames && acquireFromBinaryFile (file, values[1] + f*FRAME_LENGTH, binaryValues (&header_)) == OK; f++);
+	start = tickGet() - start;
+	close (file);
+
+	printf ("%u frames of %u samples: binary file %.1f ms\n", f, FRAME_LENGTH, (start*1000.0)/sysClkRateGet());
+
+	if (header_.type != header.type || header_.length != header.length || header_.rate != header.rate || header_.channels != header.channels) return false;
+	if (f != frames) return false;
+	for (i = 0; i < frames*FRAME_LENGTH; i++) {
+		if (values[0][i] != values[1][i]) return false;
+	}
+
+	if ((file = open (INPUT_FILE, O_RDONLY, 0444)) == ERROR) return false;
+	if (acquireHeaderFromFile (file, &header_) != BAD_FORMAT) passed = false; 				/*A text file isn't taken for a binary one*/
+	close (file);
+
+	for (i = 0; i < 2; i++) { 																/*Nor a header whose frames can't be read*/
+		if ((file = open (BINARY_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+		sendHeaderToFile (file, &forged[i]);
+		close (file);
+		if ((file = open (BINARY_FILE, O_RDONLY, 0444)) == ERROR) return false;
+		if (acquireHeaderFromFile (file, &header_) != BAD_FORMAT) passed = false;
+		close (file);
+	}
+
+	return passed;
+
+}
+
+/* Return true if files 'a' and 'b' have the same content */
+
+boolean sameFiles (const char * const a, const char * const b) {
+
+	char block[2][256];
+	int file[2];
+	int len[2];
+	boolean same;
+
+	file[0] = open ((char*)a, O_RDONLY, 0444);
+	file[1] = open ((char*)b, O_RDONLY, 0444);
+	same = (file[0] != ERROR && file[1] != ERROR);
+
+	while (same) {
+		len[0] = read (file[0], block[0], sizeof (block[0])); 								/*Regular files: reads are short only at the end*/
+		len[1] = read (file[1], block[1], sizeof (block[1]));
+		same = (len[0] == len[1] && memcmp (block[0], block[1], len[0] > 0 ? len[0] : 0) == 0);
+		if (len[0] <= 0) break;
+	}
+
+	if (file[0] != ERROR) close (file[0]);
+	if (file[1] != ERROR) close (file[1]);
+
+	return same;
+
+}
+
+/* Compare formatFixed(); with sprintf(); on FORMAT_VALUES random values (half of them on ties of the fourth decimal), and the REDUCED_VALUES written by
+ * sendRealToFile(); with REDUCED_TEXT. Then send SPECTRUM_FRAMES spectra by sendToFile(); and by a buffered writer: the two output files must be the same.
+ * The time spent by both is printed */
+
+boolean checkFormatter (void) {
+
+	const char *files[] = OUTPUT_FILES;
+	const double reduced[] = REDUCED_VALUES;
+
+	char text[2][MAX_LINE_LENGTH];
+	complex spectrum[SPECTRUM_BINS];
+	fileWriter *writer;
+	double value;
+	double elapsed[2];
+	int output;
+	ULONG start;
+	boolean passed = true;
+
+	unsigned int i, f, k;
+	for (i = 0; i < FORMAT_VALUES; i++) {
+		value = 2000*((double)rand()/RAND_MAX) - 1000;
+		if (i % 2 == 1) value = (floor (value*10000) + 0.5)/10000; 							/*Close to a tie, or exactly on it when representable*/
+		text[0][sprintf (text[0], "%+.4f", value)] = '\0';
+		text[1][formatFixed (text[1], value)] = '\0';
+		if (strcmp (text[0], text[1]) != 0) {
+			printf ("Formatter: %s instead of %s. FAILED\n", text[1], text[0]);
+			passed = false;
+			break;
+		}
+	}
+
+	if ((output = open ((char*)files[0], O_RDWR | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+	sendRealToFile (output, reduced, sizeof (reduced)/sizeof (double));
+	lseek (output, 0, SEEK_SET);
+	i = (unsigned int)read (output, text[0], MAX_LINE_LENGTH - 1);
+	close (output);
+	text[0][(i < MAX_LINE_LENGTH) ? i : 0] = '\0'; 											/*Nothing read on errors*/
+	if (strcmp (text[0], REDUCED_TEXT) != 0) {
+		printf ("Reduced values: %s instead of %s. FAILED\n", text[0], REDUCED_TEXT);
+		passed = false;
+	}
+
+	for (f = 0; f < 2; f++) {
+		if ((output = open ((char*)files[f], O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+		writer = (f == 1) ? writerCreate (output, WRITER_BLOCK) : NULL;
+		if (f == 1 && writer == NULL) {
+			close (output);
+			return false;
+		}
+		srand (1); 																			/*The same spectra for both files*/
+		start = tickGet();
+		for (i = 0; i < SPECTRUM_FRAMES; i++) {
+			for (k = 0; k < SPECTRUM_BINS; k++) { 											/*Out of range values included*/
+				spectrum[k].real = 2400*((double)rand()/RAND_MAX) - 1200;
+				spectrum[k].imag = 2400*((double)rand()/RAND_MAX) - 1200;
+			}
+			if (f == 1) sendToWriter (writer, spectrum, SPECTRUM_BINS);
+			else sendToFile (output, spectrum, SPECTRUM_BINS);
+		}
+		elapsed[f] = ((tickGet() - start)*1000.0)/sysClkRateGet();
+		if (writer != NULL) writerDestroy (writer);
+		close (output);
+	}
+
+	printf ("%u spectra of %u bins: sendToFile %.1f ms, writer %.1f ms\n", SPECTRUM_FRAMES, SPECTRUM_BINS, elapsed[0], elapsed[1]);
+
+	return passed && sameFiles (files[0], files[1]);
+
+}
+
+/* Return the milliseconds spent sending UDP_FRAMES frames taken from 'values[0]' to the port after LOOPBACK_PORT (with no receiver), by sendToUDP(); or by
+ * sendFrameToUDP(); ('packed'). A negative value is returned if the socket isn't available */
+
+double timeUDP (const boolean packed) {
+
+	udpSender *sender = NULL;
+	int UDPSocket;
+	ULONG start;
+
+	unsigned int f;
+
+	if ((UDPSocket = socket (AF_INET, SOCK_DGRAM, 0)) == ERROR) return -1;
+	if (packed) sender = senderCreate (UDPSocket, LOOPBACK_ADDRESS, LOOPBACK_PORT + 1);
+	if ((packed && sender == NULL) || (!packed && initUDP (UDPSocket, LOOPBACK_ADDRESS, LOOPBACK_PORT + 1) == ERROR)) {
+		close (UDPSocket);
+		return -1;
+	}
+
+	start = tickGet();
+	for (f = 0; f < UDP_FRAMES; f++) {
+		if (packed) sendFrameToUDP (sender, values[0] + f*UDP_LENGTH, UDP_LENGTH);
+		else sendToUDP (UDPSocket, values[0] + f*UDP_LENGTH, UDP_LENGTH);
+	}
+	start = tickGet() - start;
+
+	if (sender != NULL) senderDestroy (sender);
+	close (UDPSocket);
+
+	return (start*1000.0)/sysClkRateGet();
+
+}
+
+/* Send UDP_FRAMES frames of random samples to a receiver bound to LOOPBACK_PORT, which receives each one before the next is sent: datagrams must arrive
+ * in order, without losses, and carry the frames which have been sent. Then time sendToUDP(); and sendFrameToUDP(); */
+
+boolean checkUDP (void) {
+
+	struct sockaddr_in address;
+	struct timeval timeout = {1, 0}; 														/*A lost datagram doesn't block the test*/
+	udpSender *sender;
+	datagramHeader header;
+	char datagram[UDP_PAYLOAD];
+	double samples[DATAGRAM_SAMPLES];
+	int sockets[2];
+	int len;
+	unsigned int expected = 0;
+	unsigned int received = 0;
+	unsigned int disordered = 0;
+	unsigned int lost = 0;
+	double elapsed[2];
+	boolean passed = true;
+
+	unsigned int f, i, d;
+
+	for (i = 0; i < UDP_FRAMES*UDP_LENGTH; i++) values[0][i] = 2000*((double)rand()/RAND_MAX) - 1000;
+
+	memset (&address, 0, sizeof (address));
+	address.sin_len = (u_char)sizeof (struct sockaddr_in);
+	address.sin_family = AF_INET;
+	address.sin_port = htons (LOOPBACK_PORT);
+	address.sin_addr.s_addr = inet_addr (LOOPBACK_ADDRESS);
+
+	sockets[0] = socket (AF_INET, SOCK_DGRAM, 0); 											/*Receiver...*/
+	sockets[1] = socket (AF_INET, SOCK_DGRAM, 0); 											/*...and sender*/
+	if (sockets[0] == ERROR || sockets[1] == ERROR || bind (sockets[0], (struct sockaddr*)&address, sizeof (address)) == ERROR ||
+		setsockopt (sockets[0], SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof (timeout)) == ERROR ||
+		(sender = senderCreate (sockets[1], LOOPBACK_ADDRESS, LOOPBACK_PORT)) == NULL) {
+		printf ("UDP frames: loopback sockets not available. FAILED\n");
+		if (sockets[0] != ERROR) close (sockets[0]);
+		if (sockets[1] != ERROR) close (sockets[1]);
+		return false;
+	}
+
+	for (f = 0; f < UDP_FRAMES; f++) {
+		if (sendFrameToUDP (sender, values[0] + f*UDP_LENGTH, UDP_LENGTH) == ERROR) passed = false;
+		for (d = 0; d < (UDP_LENGTH + DATAGRAM_SAMPLES - 1)/DATAGRAM_SAMPLES; d++) {
+			if ((len = recv (sockets[0], datagram, UDP_PAYLOAD, 0)) <= 0) { 				/*Timeout*/
+				lost++;
+				continue;
+			}
+			if (decodeDatagram (datagram, (unsigned int)len, &header, samples) != OK) {
+				passed = false;
+				continue;
+			}
+			received++;
+			if (header.sequence != expected || header.frame != f || header.length != UDP_LENGTH) disordered++;
+			else frmcpy (samples, values[1] + f*UDP_LENGTH + header.offset, header.count);
+			expected = header.sequence + 1;
+		}
+	}
+
+	senderDestroy (sender);
+	close (sockets[0]);
+	close (sockets[1]);
+
+	for (i = 0; i < UDP_FRAMES*UDP_LENGTH; i++) {
+		if (values[0][i] != values[1][i]) passed = false;
+	}
+
+	elapsed[0] = timeUDP (false);
+	elapsed[1] = timeUDP (true);
+
+	printf ("%u datagrams received, %u out of order, %u lost. %u frames of %u samples: sendToUDP %.1f ms, sendFrameToUDP %.1f ms\n", received,
+		disordered, lost, UDP_FRAMES, UDP_LENGTH, elapsed[0], elapsed[1]);
+
+	return passed && disordered == 0 && lost == 0;
+
+}
+
+/* Send UDP_FRAMES frames of random samples to a relay, which forwards them to a UDP acquisition source after swapping two datagrams of every frame whose
+ * number ends by SWAPPED_FRAME, and dropping one of every frame whose number ends by DROPPED_FRAME. The source is read FRAME_LENGTH samples at a time, a
+ * frame behind the relay: acquired samples must be the ones sent (0 where dropped), counters must match the relay, and the stream must end by a timeout (no
+ * acquisition waits for it) */
+
+boolean checkReceiver (void) {
+
+	const unsigned int datagrams = (UDP_LENGTH + DATAGRAM_SAMPLES - 1)/DATAGRAM_SAMPLES;
+
+	struct sockaddr_in address[2]; 															/*Relay and acquisition source*/
+	struct timeval timeout = {1, 0};
+	udpSender *sender = NULL;
+	udpReceiver *receiver = NULL;
+	int sockets[3]; 																		/*Sender, relay and acquisition source*/
+	int len[UDP_BATCH];
+	unsigned int acquired = 0;
+	unsigned int swapped = 0;
+	unsigned int dropped = 0;
+	STATUS st = OK;
+	boolean passed = true;
+
+	unsigned int i, f, d;
+
+	for (i = 0; i < UDP_FRAMES*UDP_LENGTH; i++) values[0][i] = 2000*((double)rand()/RAND_MAX) - 1000;
+
+	for (i = 0; i < 2; i++) {
+		memset (&address[i], 0, sizeof (address[i]));
+		address[i].sin_len = (u_char)sizeof (struct sockaddr_in);
+		address[i].sin_family = AF_INET;
+		address[i].sin_port = htons (LOOPBACK_PORT + 2 + i);
+		address[i].sin_addr.s_addr = inet_addr (LOOPBACK_ADDRESS);
+	}
+	for (i = 0; i < 3; i++) sockets[i] = socket (AF_INET, SOCK_DGRAM, 0);
+
+	if (sockets[0] != ERROR && sockets[1] != ERROR && sockets[2] != ERROR && bind (sockets[1], (struct sockaddr*)&address[0], sizeof (address[0])) == OK &&
+		setsockopt (sockets[1], SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof (timeout)) == OK) {
+		sender = senderCreate (sockets[0], LOOPBACK_ADDRESS, LOOPBACK_PORT + 2);
+		receiver = receiverCreate (sockets[2], LOOPBACK_PORT + 3, UDP_WINDOW, UDP_SLACK, UDP_TIMEOUT);
+	}
+	if (sender == NULL || receiver == NULL) {
+		printf ("UDP acquisition: loopback sockets not available. FAILED\n");
+		passed = false;
+	}
+
+	for (f = 0; passed && f < UDP_FRAMES; f++) {
+		sendFrameToUDP (sender, values[0] + f*UDP_LENGTH, UDP_LENGTH);
+		for (d = 0; d < datagrams; d++) len[d] = recv (sockets[1], relayed[d], UDP_PAYLOAD, 0);
+		for (d = 0; d < datagrams; d++) {
+			if (f % 10 == DROPPED_FRAME && d == datagrams - 2) { 							/*A whole datagram is lost: its samples must be acquired as 0*/
+				for (i = 0; i < DATAGRAM_SAMPLES; i++) values[0][f*UDP_LENGTH + d*DATAGRAM_SAMPLES + i] = 0;
+				dropped++;
+				continue;
+			}
+			i = (f % 10 == SWAPPED_FRAME && d < 2) ? 1 - d : d; 							/*The first two are swapped*/
+			if (i == 0 && d == 1) swapped++;
+			if (len[i] > 0) sendto (sockets[1], relayed[i], len[i], 0, (struct sockaddr*)&address[1], sizeof (address[1]));
+		}
+		while (st != EOF_REACHED && acquired + FRAME_LENGTH + UDP_SLACK <= (f + 1)*UDP_LENGTH) {
+			st = acquireFromUDP (receiver, values[1] + acquired, FRAME_LENGTH);
+			if (st == FRAME_NOT_READY) taskDelay (1); 										/*The relayed datagrams haven't been delivered yet*/
+			else acquired += FRAME_LENGTH;
+		}
+	}
+
+	if (passed) {
+		while (st != EOF_REACHED) { 														/*The last samples, then the end of the stream*/
+			st = acquireFromUDP (receiver, values[1] + acquired, FRAME_LENGTH);
+			if (st == FRAME_NOT_READY) taskDelay (1);
+			else if (st != EOF_REACHED) acquired += FRAME_LENGTH;
+		}
+		for (i = 0; i < acquired; i++) {
+			if (values[0][i] != values[1][i]) passed = false;
+		}
+		printf ("%u samples acquired: %u datagrams received, %u lost, %u reordered, %u dropped, %u samples missing, %u acquisitions not ready\n",
+			acquired, receiver->received, receiver->lost, receiver->reordered, receiver->dropped, receiver->missing, receiver->starved);
+		passed = passed && acquired == (UDP_FRAMES*UDP_LENGTH/FRAME_LENGTH)*FRAME_LENGTH && receiver->lost == dropped &&
+			receiver->reordered == swapped && receiver->missing == dropped*DATAGRAM_SAMPLES;
+	}
+
+	if (sender != NULL) senderDestroy (sender);
+	if (receiver != NULL) receiverDestroy (receiver);
+	for (i = 0; i < 3; i++) {
+		if (sockets[i] != ERROR) close (sockets[i]);
+	}
+
+	return passed;
+
+}
+
+/* Send the SPECTRUM_FRAMES spectra of checkFormatter(); through an asynchronous sink of SINK_SLOTS slots, with SINK_BLOCK (the text must be the one of the
+ * buffered writer) and with SINK_DROP (every record accepted must be written whole), and compare the time spent by the pushing task with the writer */
+
+boolean checkSink (void) {
+
+	const char *files[] = OUTPUT_FILES;
+
+	complex spectrum[SPECTRUM_BINS];
+	asyncSink *sink;
+	double elapsed;
+	int output, len;
+	char line[MAX_LINE_LENGTH];
+	unsigned int lines = 0;
+	ULONG start;
+	boolean passed = true;
+
+	unsigned int p, i, k;
+	for (p = 0; p < 2; p++) {
+		if ((output = open ((char*)files[1], O_RDWR | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+		sink = sinkCreate (output, SINK_SLOTS, SPECTRUM_BINS*MAX_LINE_LENGTH, (p == 0) ? SINK_BLOCK : SINK_DROP, SINK_PRIO);
+		if (sink == NULL) {
+			close (output);
+			return false;
+		}
+		srand (1);
+		start = tickGet();
+		for (i = 0; i < SPECTRUM_FRAMES; i++) {
+			for (k = 0; k < SPECTRUM_BINS; k++) {
+				spectrum[k].real = 2400*((double)rand()/RAND_MAX) - 1200;
+				spectrum[k].imag = 2400*((double)rand()/RAND_MAX) - 1200;
+			}
+			sendToSink (sink, spectrum, SPECTRUM_BINS);
+		}
+		elapsed = ((tickGet() - start)*1000.0)/sysClkRateGet();
+		sinkFlush (sink); 																	/*Every record accepted is written*/
+		printf ("%s: pushes %.1f ms, %u pushed, %u dropped, %u waited, %u congested, peak %u, %u written by %u calls, %u failed\n",
+			(p == 0) ? "SINK_BLOCK" : "SINK_DROP", elapsed, sink->pushed, sink->dropped, sink->waited, sink->congested, sink->peak, sink->written,
+			sink->calls, sink->failed);
+		passed = passed && sink->pushed + sink->dropped == SPECTRUM_FRAMES && sink->written == sink->pushed && sink->failed == 0;
+		if (p == 0) passed = passed && sink->dropped == 0 && sameFiles (files[0], files[1]);
+		else {
+			lseek (output, 0, SEEK_SET);
+			while ((len = read (output, line, MAX_LINE_LENGTH)) > 0) {
+				for (i = 0; i < (unsigned int)len; i++) lines += (line[i] == '\n');
+			}
+			passed = passed && lines == sink->written*SPECTRUM_BINS;
+		}
+		sinkDestroy (sink);
+		close (output);
+	}
+
+	return passed;
+
+}
+
+/* Send UDP_LENGTH samples taken from 'values[0]' through an asynchronous sink of datagrams to a loopback receiver, a hop of UDP_BATCH samples at a time:
+ * each datagram must carry the text sendToUDP(); would send for its sample */
+
+boolean checkSampleSink (void) {
+
+	struct sockaddr_in address;
+	struct timeval timeout = {1, 0};
+	asyncSink *sink = NULL;
+	char datagram[MAX_LINE_LENGTH];
+	char text[MAX_LINE_LENGTH];
+	int sockets[2]; 																		/*Sink and receiver*/
+	int len;
+	unsigned int received = 0;
+	boolean passed = true;
+
+	unsigned int i, j;
+
+	memset (&address, 0, sizeof (address));
+	address.sin_len = (u_char)sizeof (struct sockaddr_in);
+	address.sin_family = AF_INET;
+	address.sin_port = htons (LOOPBACK_PORT + 4);
+	address.sin_addr.s_addr = inet_addr (LOOPBACK_ADDRESS);
+	for (i = 0; i < 2; i++) sockets[i] = socket (AF_INET, SOCK_DGRAM, 0);
+
+	if (sockets[0] != ERROR && sockets[1] != ERROR && bind (sockets[1], (struct sockaddr*)&address, sizeof (address)) == OK &&
+		setsockopt (sockets[1], SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof (timeout)) == OK) {
+		sink = sinkCreateUDP (sockets[0], LOOPBACK_ADDRESS, LOOPBACK_PORT + 4, SAMPLE_SLOTS, MAX_LINE_LENGTH, SINK_BLOCK, SINK_PRIO);
+	}
+	if (sink == NULL) {
+		printf ("Sample sink: loopback sockets not available. FAILED\n");
+		passed = false;
+	}
+
+	for (i = 0; passed && i < UDP_LENGTH; i += UDP_BATCH) { 								/*The receiver keeps up with the sink*/
+		sendSamplesToSink (sink, values[0] + i, (UDP_LENGTH - i < UDP_BATCH) ? UDP_LENGTH - i : UDP_BATCH);
+		for (j = i; j < i + UDP_BATCH && j < UDP_LENGTH; j++) {
+			if ((len = recv (sockets[1], datagram, MAX_LINE_LENGTH, 0)) <= 0) break;
+			if (len != sprintf (text, "%+.4f\n", values[0][j]) || memcmp (datagram, text, len) != 0) passed = false;
+			received++;
+		}
+	}
+
+	if (sink != NULL) {
+		sinkFlush (sink);
+		printf ("%u samples: %u datagrams received, %u written by %u calls, %u failed\n", UDP_LENGTH, received, sink->written, sink->calls,
+			sink->failed);
+		passed = passed && received == UDP_LENGTH && sink->failed == 0;
+		sinkDestroy (sink);
+	}
+	for (i = 0; i < 2; i++) {
+		if (sockets[i] != ERROR) close (sockets[i]);
+	}
+
+	return passed;
+
+}
+
+/* Take the frames of FRAME_LENGTH samples of INPUT_FILE from a prefetching source of PREFETCH_BUFFERS frames, waiting a tick whenever none is ready: they
+ * must be the ones acquired by a buffered reader, up to the end of file. Then take them again through a frame source, from a prefetching source filling
+ * the frames of a pool of POOL_FRAMES frames: they must be frames of that pool, all back in it at the end */
+
+boolean checkPrefetch (void) {
+
+	prefetchSource *source;
+	framePool *pool;
+	frameSource *prefetched;
+	dspFrame *taken;
+	double *frame;
+	unsigned int frames[2] = {0, 0};
+	int input;
+	ULONG start, swaps = 0; 																/*Ticks spent by the acquisitions alone*/
+	STATUS st;
+	boolean passed = true;
+
+	unsigned int i;
+
+	if (acquireInput (false, &frames[0]) < 0 || (input = open (INPUT_FILE, O_RDONLY, 0444)) == ERROR) return false;
+	if ((source = prefetchCreate (input, FRAME_LENGTH, PREFETCH_BUFFERS, SINK_PRIO)) == NULL) {
+		close (input);
+		return false;
+	}
+
+	do {
+		start = tickGet();
+		st = prefetchAcquire (source, &frame);
+		swaps += tickGet() - start;
+		if (st == FRAME_NOT_READY) taskDelay (1);
+		else if (st != EOF_REACHED) {
+			for (i = 0; i < FRAME_LENGTH; i++) {
+				if (frames[1] >= frames[0] || frame[i] != values[0][frames[1]*FRAME_LENGTH + i]) passed = false;
+			}
+			frames[1]++;
+		}
+	} while (st != EOF_REACHED && frames[1] <= frames[0]);
+
+	printf ("%u frames of %u samples: %u acquisitions found no frame ready, %.1f ms spent by the acquisitions\n", frames[1], FRAME_LENGTH,
+		source->starved, (swaps*1000.0)/sysClkRateGet());
+
+	prefetchDestroy (source);
+	close (input);
+	passed = passed && frames[1] == frames[0];
+
+	if ((input = open (INPUT_FILE, O_RDONLY, 0444)) == ERROR || (pool = poolCreate (POOL_FRAMES, FRAME_LENGTH)) == NULL) return false;
+	source = prefetchCreate_ (input, FRAME_LENGTH, PREFETCH_BUFFERS, SINK_PRIO, pool);
+	prefetched = (source != NULL) ? sourceFromPrefetch (source) : NULL;
+	frames[1] = 0;
+	do {
+		st = (prefetched != NULL) ? sourceAcquire (prefetched, &taken) : ERROR;
+		if (st == FRAME_NOT_READY) taskDelay (1);
+		else if (st == OK || st == MALFORMED_SAMPLE) {
+			if (taken->pool != pool || frames[1] >= frames[0]) passed = false;
+			for (i = 0; i < FRAME_LENGTH && frames[1] < frames[0]; i++) {
+				if (taken->samples[i] != values[0][frames[1]*FRAME_LENGTH + i]) passed = false;
+			}
+			frameRelease (taken);
+			frames[1]++;
+		}
+	} while ((st == OK || st == MALFORMED_SAMPLE || st == FRAME_NOT_READY) && frames[1] <= frames[0]);
+
+	if (prefetched != NULL) frameSourceDestroy (prefetched);
+	if (source != NULL) prefetchDestroy (source);
+	for (i = 0; i < POOL_FRAMES; i++) { 													/*Frames still queued are released by prefetchDestroy();*/
+		if (vxAtomicGet (&pool->frames[i].references) != 0) passed = false;
+	}
+	poolDestroy (pool);
+	close (input);
+
+	return passed && st == EOF_REACHED && frames[1] == frames[0];
+
+}
+
+/* Acquire INPUT_FILE through a frame source, hand each frame to a second stage by reference and write it by a frame sink to the first output file, while
+ * the second one is written by a buffered writer from the frames of a buffered reader: frames and files must be the same. Frames must be aligned, and
+ * the source must report an exhausted pool without losing samples */
+
+boolean checkFrames (void) {
+
+	const char *files[] = OUTPUT_FILES;
+
+	framePool *pool;
+	frameSource *source;
+	frameSink *sink;
+	dspFrame *frame;
+	dspFrame *held[POOL_FRAMES];
+	fileReader *reader;
+	fileWriter *writer[2];
+	unsigned int frames[2] = {0, 0};
+	int input, output[2];
+	STATUS st;
+	boolean passed = true;
+
+	unsigned int i, f;
+
+	if (acquireInput (false, &frames[0]) < 0 || (pool = poolCreate (POOL_FRAMES, FRAME_LENGTH)) == NULL) return false;
+	for (i = 0; i < POOL_FRAMES; i++) {
+		if ((size_t)pool->frames[i].samples % SPLIT_ALIGNMENT != 0) passed = false;
+	}
+
+	input = open (INPUT_FILE, O_RDONLY, 0444);
+	output[0] = open ((char*)files[0], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	output[1] = open ((char*)files[1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	reader = readerCreate (input, READER_BLOCK);
+	writer[0] = writerCreate (output[0], WRITER_BLOCK);
+	writer[1] = writerCreate (output[1], WRITER_BLOCK);
+	source = (reader != NULL) ? sourceFromReader (reader, pool, FRAME_LENGTH) : NULL;
+	sink = (writer[0] != NULL) ? sinkToWriter (writer[0]) : NULL;
+	if (source == NULL || sink == NULL || writer[1] == NULL) passed = false;
+
+	while (source != NULL && sink != NULL && writer[1] != NULL) {
+		if (frames[1] == 1) { 																/*Hold the whole pool: nothing can be acquired*/
+			for (i = 0; i < POOL_FRAMES; i++) held[i] = frameAlloc (pool);
+			if (sourceAcquire (source, &frame) != POOL_EXHAUSTED || frame != NULL || frameAlloc (pool) != NULL) passed = false;
+			for (i = 0; i < POOL_FRAMES; i++) {
+				if (held[i] != NULL) frameRelease (held[i]);
+			}
+		}
+		if ((st = sourceAcquire (source, &frame)) == EOF_REACHED) break;
+		if (frame == NULL || frames[1] >= frames[0]) {
+			passed = false;
+			break;
+		}
+		for (i = 0; i < FRAME_LENGTH; i++) {
+			if (frame->samples[i] != values[0][frames[1]*FRAME_LENGTH + i]) passed = false;
+		}
+		frameRetain (frame); 																/*Handed to the second stage...*/
+		frameRelease (frame); 																/*...and released by the first one*/
+		if (vxAtomicGet (&frame->references) != 1) passed = false;
+		sinkSend (sink, frame);
+		frameRelease (frame);
+		sendRealToWriter (writer[1], values[0] + frames[1]*FRAME_LENGTH, FRAME_LENGTH);
+		frames[1]++;
+	}
+
+	printf ("%u frames of %u samples through a pool of %u frames, %u allocations found the pool exhausted\n", frames[1], FRAME_LENGTH, POOL_FRAMES,
+		(unsigned int)vxAtomicGet (&pool->exhausted));
+
+	if (sink != NULL) frameSinkDestroy (sink);
+	if (source != NULL) frameSourceDestroy (source);
+	for (f = 0; f < 2; f++) {
+		if (writer[f] != NULL) writerDestroy (writer[f]);
+		if (output[f] != ERROR) close (output[f]);
+	}
+	if (reader != NULL) readerDestroy (reader);
+	if (input != ERROR) close (input);
+	poolDestroy (pool);
+
+	return passed && frames[1] == frames[0] && sameFiles (files[0], files[1]);
+
+}
+
+/* Compress the 'frames' spectra of 'type' taken from 'spectra' with the quantization step 'precision' BENCHMARK_RUNS times, then decode them and compare
+ * them with the sent ones. Throughputs (doubles coded per second) and sizes, compared with the text and binary output, are printed */
+
+boolean benchmarkCodec (const sampleType type, const double precision, const unsigned int frames) {
+
+	const char *files[] = OUTPUT_FILES;
+	const double * const sent = spectra[type == SAMPLE_COMPLEX ? 0 : 1];
+
+	spectrumCodec *codec = NULL;
+	fileWriter *writer;
+	double decoded[CODEC_FRAME + 2];
+	double error = 0;
+	double elapsed[2];
+	double megabytes;
+	unsigned long long bytes[2] = {0, 0};
+	unsigned int values = (type == SAMPLE_COMPLEX) ? CODEC_FRAME + 2 : CODEC_FRAME/2 + 1;
+	unsigned int decodedFrames = 0;
+	int output, input;
+	ULONG start;
+	boolean passed = true;
+
+	unsigned int run, f, k;
+
+	if ((output = open ((char*)files[1], O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+	if ((writer = writerCreate (output, WRITER_BLOCK)) != NULL) { 							/*Text output, for comparison*/
+		for (f = 0; f < frames; f++) {
+			if (type == SAMPLE_COMPLEX) sendToWriter (writer, (const complex*)(sent + f*values), CODEC_FRAME/2 + 1);
+			else sendRealToWriter (writer, sent + f*values, CODEC_FRAME/2 + 1);
+		}
+		writerDestroy (writer);
+	}
+	bytes[0] = (unsigned long long)lseek (output, 0, SEEK_END);
+	close (output);
+	if (writer == NULL) return false;
+
+	start = tickGet();
+	for (run = 0; run < BENCHMARK_RUNS && passed; run++) {
+		if ((output = open ((char*)files[0], O_WRONLY | O_CREAT | O_TRUNC, 0644)) == ERROR) return false;
+		if ((codec = encoderCreate (output, type, CODEC_FRAME/2 + 1, precision)) == NULL) passed = false;
+		for (f = 0; f < frames && passed; f++) {
+			if (sendToEncoder (codec, sent + f*values) != OK) passed = false;
+		}
+		if (codec != NULL) {
+			bytes[1] = codec->bytes;
+			codecDestroy (codec);
+		}
+		close (output);
+	}
+	elapsed[0] = (double)(tickGet() - start)/sysClkRateGet();
+
+	start = tickGet();
+	for (run = 0; run < BENCHMARK_RUNS && passed; run++) { 									/*Streaming: a record read at a time*/
+		if ((input = open ((char*)files[0], O_RDONLY, 0444)) == ERROR) return false;
+		if ((codec = decoderCreate (input)) == NULL || codec->type != type || codec->precision != precision) passed = false;
+		decodedFrames = 0;
+		while (passed && acquireFromDecoder (codec, decoded) == OK) {
+			if (decodedFrames == frames) passed = false;
+			for (k = 0; k < values && run == 0 && passed; k++) error = fmax (error, fabs (decoded[k] - sent[decodedFrames*values + k]));
+			decodedFrames++;
+		}
+		if (codec != NULL) codecDestroy (codec);
+		close (input);
+	}
+	elapsed[1] = (double)(tickGet() - start)/sysClkRateGet();
+
+	if (!passed) return false;
+
+	megabytes = (double)BENCHMARK_RUNS*frames*values*sizeof (double)/1e6;
+	printf ("%s, precision %g: %u frames, text %.2f MB, binary %.2f MB, compressed %.2f MB (ratio %.1f to text, %.1f to binary)\n",
+		(type == SAMPLE_COMPLEX) ? "Complex bins" : "Levels (dB)", precision, frames, bytes[0]/1e6, frames*values*sizeof (double)/1e6, bytes[1]/1e6,
+		(double)bytes[0]/bytes[1], (double)frames*values*sizeof (double)/bytes[1]);
+	printf ("Encoding %.0f MB/s, decoding %.0f MB/s (of doubles), maximum error %g\n", megabytes/elapsed[0], megabytes/elapsed[1], error);
+
+	return decodedFrames == frames && error <= precision*(0.5 + 1e-6);
+
+}
+
+/* Evaluate the spectra of INPUT_FILE (complex bins and their levels in dB) and benchmark their compressed output */
+
+boolean checkCodec (void) {
+
+	const double precisions[] = CODEC_PRECISIONS;
+
+	stft *stream;
+	unsigned int samples;
+	unsigned int frames = 0;
+	double *bins;
+	boolean passed = true;
+
+	unsigned int hop, k, p;
+
+	if (acquireInput (false, &samples) < 0 || (stream = stftCreate (CODEC_FRAME, CODEC_HOP, WINDOW_HANN)) == NULL) return false;
+	samples *= FRAME_LENGTH;
+
+	spectra[0] = (double*)malloc ((samples/CODEC_HOP)*(CODEC_FRAME + 2)*sizeof (double));
+	spectra[1] = (double*)malloc ((samples/CODEC_HOP)*(CODEC_FRAME/2 + 1)*sizeof (double));
+	for (hop = 0; hop + CODEC_HOP <= samples && spectra[0] != NULL && spectra[1] != NULL; hop += CODEC_HOP) {
+		frmcpy (values[0] + hop, stftSlot (stream), CODEC_HOP);
+		if (stftPush (stream) != OK) continue; 												/*The first frame is still incomplete*/
+		bins = spectra[0] + frames*(CODEC_FRAME + 2);
+		stftExecute (stream, (complex*)bins);
+		for (k = 0; k <= CODEC_FRAME/2; k++) {
+			spectra[1][frames*(CODEC_FRAME/2 + 1) + k] = 20*log10 (fmax (hypot (bins[2*k], bins[2*k + 1]), 1e-12));
+		}
+		frames++;
+	}
+
+	for (p = 0; p < sizeof (precisions)/sizeof (double) && frames > 0; p++) {
+		if (!benchmarkCodec (SAMPLE_COMPLEX, precisions[p], frames) || !benchmarkCodec (SAMPLE_REAL, precisions[p], frames)) passed = false;
+	}
+
+	free (spectra[0]);
+	free (spectra[1]);
+	stftDestroy (stream);
+
+	return passed && frames > 0;
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Init VxWorks function */
+
+void init () {
+
+	const char *files[] = OUTPUT_FILES;
+
+	printf ("Sample parser: %s\n", checkParser() ? "PASSED" : "FAILED");
+
+	printf ("Parser throughput: %s\n", benchmarkParser() ? "PASSED" : "FAILED");
+
+	printf ("Mapped input: %s\n", checkMapping() ? "PASSED" : "FAILED");
+
+	printf ("Binary files: %s\n", checkBinary() ? "PASSED" : "FAILED");
+
+	printf ("Text output: %s\n", checkFormatter() ? "PASSED" : "FAILED");
+
+	printf ("UDP frames: %s\n", checkUDP() ? "PASSED" : "FAILED");
+
+	printf ("UDP acquisition: %s\n", checkReceiver() ? "PASSED" : "FAILED");
+
+	printf ("Asynchronous sinks: %s\n", checkSink() ? "PASSED" : "FAILED");
+
+	printf ("Sample sink: %s\n", checkSampleSink() ? "PASSED" : "FAILED");
+
+	printf ("Prefetched input: %s\n", checkPrefetch() ? "PASSED" : "FAILED");
+
+	printf ("Frame sources and sinks: %s\n", checkFrames() ? "PASSED" : "FAILED");
+
+	printf ("Compressed output: %s\n", checkCodec() ? "PASSED" : "FAILED");
+
+	remove (BINARY_FILE); 																	/*Only INPUT_FILE is left*/
+	remove (files[0]);
+	remove (files[1]);
+
+}
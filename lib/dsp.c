@@ -1,44 +1,1355 @@
-/*
- * Author: Alessandro Trifoglio
- * Last revision: 21/12/2016
- */
-
-/* H library */
-
-#include "dsp.h"
-
-/* Generic private libraries */
-
-#include "math.h"
-
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Pi */
-
-#define PI 											3.14159
-
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the algebraic definition, and write them in 'frameF' */
-
-void sft (const double * const frameT, complex * const frameF, const unsigned int n) {
-
-	complex sum;
-
-	unsigned int p, q;
-
-	for (p = 0; p < n; p++) {
-		sum.real = 0;
-		sum.imag = 0;
-		for (q = 0; q < n; q++) {
-			sum.real += frameT[q]*cos((2*PI*p*q)/n);
-			sum.imag -= frameT[q]*sin((2*PI*p*q)/n);
-		}
-		frameF[p] = sum;
-	}
-
-}
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 21/12/2016
+ */
+
+/* H library */
+
+#include "dsp.h"
+
+/* Project private libraries */
+
+#include "dspKernel.h"
+
+/* Generic private libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+
+/* VxWorks private libraries */
+
+#include "memLib.h" 								/*For memalign(); utility*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Pi */
+
+#define PI 											3.14159265358979323846
+
+/* Constants of the radix-3 and radix-5 transforms */
+
+#define SIN_2PI_3 									0.86602540378443864676
+#define COS_2PI_5 									0.30901699437494742410
+#define COS_4PI_5 									-0.80901699437494742410
+#define SIN_2PI_5 									0.95105651629515357212
+#define SIN_4PI_5 									0.58778525229247312917
+
+/* Range of Q15 values, and value of 1 */
+
+#define Q15_MIN 									-32768
+#define Q15_MAX 									32767
+#define Q15_ONE 									32768.0
+
+/* Largest radix of the mixed-radix algorithm */
+
+#define MAX_RADIX 									5
+
+/* Maximum number of plans kept in cache (plans created beyond this limit are still valid, but not shared) */
+
+#define MAX_PLANS 									16
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Cache of plans shared among tasks (NULL entries are free) */
+
+fftPlan *plans[MAX_PLANS];
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Return the base-2 logarithm of 'n' if it's a power of 2, -1 otherwise */
+
+int log2n (const unsigned int n) {
+
+	int bits = 0;
+
+	if (n == 0 || (n & (n - 1)) != 0) return -1;
+
+	while ((1u << bits) < n) bits++;
+
+	return bits;
+
+}
+
+/* Reverse the order of the lowest 'bits' bits of 'index' */
+
+unsigned int reverseBits (unsigned int index, const unsigned int bits) {
+
+	unsigned int reversed = 0;
+
+	unsigned int i;
+	for (i = 0; i < bits; i++) {
+		reversed = (reversed << 1) | (index & 1);
+		index >>= 1;
+	}
+
+	return reversed;
+
+}
+
+/* Look for a cached plan of length 'n' using 'kernel' and, if it's found, acquire a reference to it. To be called with preemption disabled */
+
+fftPlan* findPlan (const unsigned int n, const dspKernel * const kernel) {
+
+	unsigned int i;
+	for (i = 0; i < MAX_PLANS; i++) {
+		if (plans[i] != NULL && plans[i]->n == n && plans[i]->kernel == kernel) {
+			plans[i]->refs++;
+			return plans[i];
+		}
+	}
+
+	return NULL;
+
+}
+
+/* Free a plan and its tables */
+
+void freePlan (fftPlan * const plan) {
+
+	free (plan->bitrev);
+	free (plan->twiddle);
+	if (plan->twiddleSplit != NULL) splitDestroy (plan->twiddleSplit);
+	free (plan->twiddleFloat);
+	free (plan->twiddleQ15);
+	if (plan->inner != NULL) fftDestroy (plan->inner);
+	free (plan->chirp);
+	free (plan->filter);
+	free (plan->scratch);
+	free (plan);
+
+}
+
+/* Copy 'plan->n' complex values, whose real and imaginary parts are read from 'real' and 'imag' (NULL for real values) with stride 'stride', into 'out' in
+ * the order given by 'plan->bitrev' */
+
+void scatter_ (const fftPlan * const plan, const double * const real, const double * const imag, const unsigned int stride, complex * const out) {
+
+	unsigned int q;
+
+	for (q = 0; q < plan->n; q++) {
+		out[plan->bitrev[q]].real = real[q*stride];
+		out[plan->bitrev[q]].imag = (imag != NULL) ? imag[q*stride] : 0;
+	}
+
+}
+
+/* Overload of the previous routine for complex values 'in' */
+
+void scatter (const fftPlan * const plan, const complex * const in, complex * const out) {
+
+	scatter_ (plan, &in->real, &in->imag, 2, out);
+
+}
+
+/* Permute 'plan->n' complex values of 'data' in place, in bit-reversed order (radix-2 plans only) */
+
+void bitReverse (const fftPlan * const plan, complex * const data) {
+
+	complex t;
+
+	unsigned int q;
+
+	for (q = 0; q < plan->n; q++) {
+		if (q < plan->bitrev[q]) {
+			t = data[q];
+			data[q] = data[plan->bitrev[q]];
+			data[plan->bitrev[q]] = t;
+		}
+	}
+
+}
+
+/* Apply all the radix-2 butterflies of 'plan' to 'data', whose samples are already in bit-reversed order */
+
+void butterflies (const fftPlan * const plan, complex * const data) {
+
+	const unsigned int n = plan->n;
+	const butterflyKernel butterfly = plan->kernel->butterfly;
+
+	unsigned int m, h, k;
+
+	for (m = 2; m <= n; m <<= 1) {
+		h = m/2;
+		for (k = 0; k < n; k += m) butterfly (&data[k], &data[k + h], &plan->twiddle[h - 1], h);
+	}
+
+}
+
+/* Split-complex version of butterflies(); */
+
+void butterfliesSplit (const fftPlan * const plan, splitFrame * const data) {
+
+	const unsigned int n = plan->n;
+	const butterflySplitKernel butterfly = plan->kernel->butterflySplit;
+	const double * const wr = plan->twiddleSplit->real;
+	const double * const wi = plan->twiddleSplit->imag;
+
+	unsigned int m, h, k;
+
+	for (m = 2; m <= n; m <<= 1) {
+		h = m/2;
+		for (k = 0; k < n; k += m) {
+			butterfly (&data->real[k], &data->imag[k], &data->real[k + h], &data->imag[k + h], &wr[h - 1], &wi[h - 1], h);
+		}
+	}
+
+}
+
+/* Evaluate in place the transform of 'p' complex values 'x', for radices 2, 3, 4 and 5 */
+
+void radix (complex * const x, const unsigned int p) {
+
+	complex a1, a2, b1, b2, t1, t2;
+
+	switch (p) {
+		case (2):
+			t1 = x[1];
+			x[1].real = x[0].real - t1.real;
+			x[1].imag = x[0].imag - t1.imag;
+			x[0].real += t1.real;
+			x[0].imag += t1.imag;
+			break;
+		case (3):
+			a1.real = x[1].real + x[2].real;
+			a1.imag = x[1].imag + x[2].imag;
+			b1.real = SIN_2PI_3*(x[1].real - x[2].real);
+			b1.imag = SIN_2PI_3*(x[1].imag - x[2].imag);
+			t1.real = x[0].real - 0.5*a1.real;
+			t1.imag = x[0].imag - 0.5*a1.imag;
+			x[0].real += a1.real;
+			x[0].imag += a1.imag;
+			x[1].real = t1.real + b1.imag; 													/*t1 - j*b1*/
+			x[1].imag = t1.imag - b1.real;
+			x[2].real = t1.real - b1.imag; 													/*t1 + j*b1*/
+			x[2].imag = t1.imag + b1.real;
+			break;
+		case (4):
+			a1.real = x[0].real + x[2].real;
+			a1.imag = x[0].imag + x[2].imag;
+			b1.real = x[0].real - x[2].real;
+			b1.imag = x[0].imag - x[2].imag;
+			a2.real = x[1].real + x[3].real;
+			a2.imag = x[1].imag + x[3].imag;
+			b2.real = x[1].real - x[3].real;
+			b2.imag = x[1].imag - x[3].imag;
+			x[0].real = a1.real + a2.real;
+			x[0].imag = a1.imag + a2.imag;
+			x[2].real = a1.real - a2.real;
+			x[2].imag = a1.imag - a2.imag;
+			x[1].real = b1.real + b2.imag; 													/*b1 - j*b2*/
+			x[1].imag = b1.imag - b2.real;
+			x[3].real = b1.real - b2.imag; 													/*b1 + j*b2*/
+			x[3].imag = b1.imag + b2.real;
+			break;
+		case (5):
+			a1.real = x[1].real + x[4].real;
+			a1.imag = x[1].imag + x[4].imag;
+			b1.real = x[1].real - x[4].real;
+			b1.imag = x[1].imag - x[4].imag;
+			a2.real = x[2].real + x[3].real;
+			a2.imag = x[2].imag + x[3].imag;
+			b2.real = x[2].real - x[3].real;
+			b2.imag = x[2].imag - x[3].imag;
+			t1.real = x[0].real + COS_2PI_5*a1.real + COS_4PI_5*a2.real; 					/*Real (cosine) parts of bins 1 and 4...*/
+			t1.imag = x[0].imag + COS_2PI_5*a1.imag + COS_4PI_5*a2.imag;
+			t2.real = x[0].real + COS_4PI_5*a1.real + COS_2PI_5*a2.real; 					/*...and of bins 2 and 3*/
+			t2.imag = x[0].imag + COS_4PI_5*a1.imag + COS_2PI_5*a2.imag;
+			a1.real = SIN_2PI_5*b1.real + SIN_4PI_5*b2.real; 								/*Imaginary (sine) parts of bins 1 and 4...*/
+			a1.imag = SIN_2PI_5*b1.imag + SIN_4PI_5*b2.imag;
+			a2.real = SIN_4PI_5*b1.real - SIN_2PI_5*b2.real; 								/*...and of bins 2 and 3*/
+			a2.imag = SIN_4PI_5*b1.imag - SIN_2PI_5*b2.imag;
+			x[0].real += x[1].real + x[2].real + x[3].real + x[4].real;
+			x[0].imag += x[1].imag + x[2].imag + x[3].imag + x[4].imag;
+			x[1].real = t1.real + a1.imag; 													/*t1 - j*a1*/
+			x[1].imag = t1.imag - a1.real;
+			x[4].real = t1.real - a1.imag; 													/*t1 + j*a1*/
+			x[4].imag = t1.imag + a1.real;
+			x[2].real = t2.real + a2.imag; 													/*t2 - j*a2*/
+			x[2].imag = t2.imag - a2.real;
+			x[3].real = t2.real - a2.imag; 													/*t2 + j*a2*/
+			x[3].imag = t2.imag + a2.real;
+			break;
+		default:
+			break;
+	}
+
+}
+
+/* Apply all the mixed-radix stages of 'plan' to the values whose real and imaginary parts are read from 'real' and 'imag', 'step' doubles apart (2 for
+ * complex values, 1 for split-complex ones), already in digit-reversed order */
+
+void stages (const fftPlan * const plan, double * const real, double * const imag, const unsigned int step) {
+
+	const unsigned int n = plan->n;
+
+	complex x[MAX_RADIX];
+	const complex *w = plan->twiddle;
+	double t;
+
+	unsigned int length, p, s, base, k, q;
+
+	for (length = 1, s = 0; s < plan->stages; length *= p, s++) {
+		p = plan->factors[s];
+		for (base = 0; base < n; base += p*length) {
+			for (k = 0; k < length; k++) {
+				x[0].real = real[(base + k)*step];
+				x[0].imag = imag[(base + k)*step];
+				for (q = 1; q < p; q++) { 													/*Gather and twiddle the 'k'-th value of each of the 'p' merged transforms...*/
+					x[q].real = real[(base + k + q*length)*step];
+					x[q].imag = imag[(base + k + q*length)*step];
+					t = x[q].real*w[k*(p - 1) + q - 1].real - x[q].imag*w[k*(p - 1) + q - 1].imag;
+					x[q].imag = x[q].real*w[k*(p - 1) + q - 1].imag + x[q].imag*w[k*(p - 1) + q - 1].real;
+					x[q].real = t;
+				}
+				radix (x, p); 																/*...combine them...*/
+				for (q = 0; q < p; q++) { 													/*...and scatter the results*/
+					real[(base + k + q*length)*step] = x[q].real;
+					imag[(base + k + q*length)*step] = x[q].imag;
+				}
+			}
+		}
+		w += (p - 1)*length;
+	}
+
+}
+
+/* Evaluate the transform of 'plan->n' complex values read as in scatter_();, and write the results in 'out'. For Bluestein plans, 'out' may also be
+ * 'plan->scratch', which belongs to the calling task (plans with a work buffer are never shared) */
+
+void transform (const fftPlan * const plan, const double * const real, const double * const imag, const unsigned int stride, complex * const out) {
+
+	const unsigned int n = plan->n;
+	complex * const scratch = plan->scratch;
+
+	complex t;
+
+	unsigned int k;
+
+	switch (plan->algorithm) {
+		case (FFT_RADIX2):
+			scatter_ (plan, real, imag, stride, out);
+			butterflies (plan, out);
+			break;
+		case (FFT_MIXED_RADIX):
+			scatter_ (plan, real, imag, stride, out);
+			stages (plan, &out->real, &out->imag, 2);
+			break;
+		case (FFT_BLUESTEIN):
+			for (k = 0; k < n; k++) { 														/*Input samples are modulated by the chirp...*/
+				t.real = real[k*stride];
+				t.imag = (imag != NULL) ? imag[k*stride] : 0;
+				scratch[k].real = t.real*plan->chirp[k].real - t.imag*plan->chirp[k].imag;
+				scratch[k].imag = t.real*plan->chirp[k].imag + t.imag*plan->chirp[k].real;
+			}
+			for (k = n; k < plan->m; k++) {
+				scratch[k].real = 0;
+				scratch[k].imag = 0;
+			}
+			bitReverse (plan->inner, scratch); 												/*...convolved with the conjugate chirp in the frequency domain...*/
+			butterflies (plan->inner, scratch);
+			plan->kernel->multiply (scratch, plan->filter, plan->m);
+			for (k = 0; k < plan->m; k++) scratch[k].imag = -scratch[k].imag; 				/*...back to the time domain as conj(fft(conj(X)))...*/
+			bitReverse (plan->inner, scratch);
+			butterflies (plan->inner, scratch);
+			for (k = 0; k < n; k++) { 														/*...and demodulated by the chirp*/
+				t.real = scratch[k].real;
+				t.imag = -scratch[k].imag;
+				out[k].real = t.real*plan->chirp[k].real - t.imag*plan->chirp[k].imag;
+				out[k].imag = t.real*plan->chirp[k].imag + t.imag*plan->chirp[k].real;
+			}
+			break;
+		default:
+			break;
+	}
+
+}
+
+/* Split-complex version of transform(); */
+
+void transformSplit (const fftPlan * const plan, const double * const real, const double * const imag, const unsigned int stride, splitFrame * const out) {
+
+	unsigned int q;
+
+	if (plan->algorithm != FFT_BLUESTEIN) { 												/*Radix-2 and mixed-radix stages work in place on 'out'...*/
+		for (q = 0; q < plan->n; q++) {
+			out->real[plan->bitrev[q]] = real[q*stride];
+			out->imag[plan->bitrev[q]] = (imag != NULL) ? imag[q*stride] : 0;
+		}
+		if (plan->algorithm == FFT_RADIX2) butterfliesSplit (plan, out);
+		else stages (plan, out->real, out->imag, 1);
+	}
+	else { 																					/*...Bluestein ones on interleaved values in 'plan->scratch'*/
+		transform (plan, real, imag, stride, plan->scratch);
+		splitFromComplex (plan->scratch, out, plan->n);
+	}
+
+}
+
+/* Round 'value' to the nearest Q15 value, saturating it to [-1, 1) */
+
+q15 toQ15 (const double value) {
+
+	const double scaled = floor(value*Q15_ONE + 0.5);
+
+	if (scaled < Q15_MIN) return Q15_MIN;
+	if (scaled > Q15_MAX) return Q15_MAX;
+
+	return (q15)scaled;
+
+}
+
+/* Saturate 'value' to the range of Q15 values */
+
+q15 saturate (const long long value) {
+
+	if (value < Q15_MIN) return Q15_MIN;
+	if (value > Q15_MAX) return Q15_MAX;
+
+	return (q15)value;
+
+}
+
+/* Single-precision version of transform(); (radix-2 plans only) */
+
+void transformFloat (const fftPlan * const plan, const float * const real, const float * const imag, const unsigned int stride, complexf * const out) {
+
+	const unsigned int n = plan->n;
+	const butterflyFloatKernel butterfly = plan->kernel->butterflyFloat;
+
+	unsigned int q, m, h, k;
+
+	for (q = 0; q < n; q++) {
+		out[plan->bitrev[q]].real = real[q*stride];
+		out[plan->bitrev[q]].imag = (imag != NULL) ? imag[q*stride] : 0;
+	}
+
+	for (m = 2; m <= n; m <<= 1) {
+		h = m/2;
+		for (k = 0; k < n; k += m) butterfly (&out[k], &out[k + h], &plan->twiddleFloat[h - 1], h);
+	}
+
+}
+
+/* Q15 version of transform(); (radix-2 plans only): each stage halves its results, so that 'out' holds the transform divided by 'plan->n' */
+
+void transformQ15 (const fftPlan * const plan, const q15 * const real, const q15 * const imag, const unsigned int stride, complexq15 * const out) {
+
+	const unsigned int n = plan->n;
+
+	complexq15 *a, *b;
+	const complexq15 *w;
+	int tr, ti; 																			/*Products of Q15 values are Q30 values: they fit 32-bit integers*/
+
+	unsigned int q, m, h, k, j;
+
+	for (q = 0; q < n; q++) {
+		out[plan->bitrev[q]].real = real[q*stride];
+		out[plan->bitrev[q]].imag = (imag != NULL) ? imag[q*stride] : 0;
+	}
+
+	for (m = 2; m <= n; m <<= 1) {
+		h = m/2;
+		for (k = 0; k < n; k += m) {
+			for (j = 0; j < h; j++) {
+				a = &out[k + j];
+				b = &out[k + j + h];
+				w = &plan->twiddleQ15[h - 1 + j];
+				tr = ((int)b->real*w->real - (int)b->imag*w->imag)/2; 						/*Q29: the sums below can't overflow*/
+				ti = ((int)b->real*w->imag + (int)b->imag*w->real)/2;
+				b->real = saturate (((int)a->real*16384 - tr + 16384) >> 15); 				/*(a - t)/2 and (a + t)/2, rounded to Q15*/
+				b->imag = saturate (((int)a->imag*16384 - ti + 16384) >> 15);
+				a->real = saturate (((int)a->real*16384 + tr + 16384) >> 15);
+				a->imag = saturate (((int)a->imag*16384 + ti + 16384) >> 15);
+			}
+		}
+	}
+
+}
+
+/* Turn the complex transform of length 'n/2' of packed real samples (even ones as real parts, odd ones as imaginary parts) held by 'frameF' into the
+ * 'n/2+1' non-redundant bins of their real transform of length 'n', in place */
+
+void separate (const rfftPlan * const plan, complex * const frameF) {
+
+	const unsigned int n = plan->half->n;
+
+	complex a, b, e, o, t;
+
+	unsigned int k;
+
+	a = frameF[0];
+	frameF[0].real = a.real + a.imag;
+	frameF[0].imag = 0;
+	frameF[n].real = a.real - a.imag;
+	frameF[n].imag = 0;
+
+	for (k = 1; k <= n/2; k++) { 															/*Bins 'k' and 'n-k' are separated into even and odd spectra and recombined in place*/
+		a = frameF[k];
+		b = frameF[n - k];
+		e.real = (a.real + b.real)/2; 														/*Even samples: (A + conj(B))/2*/
+		e.imag = (a.imag - b.imag)/2;
+		o.real = (a.imag + b.imag)/2; 														/*Odd samples: -j*(A - conj(B))/2*/
+		o.imag = (b.real - a.real)/2;
+		t.real = o.real*plan->twiddle[k].real - o.imag*plan->twiddle[k].imag;
+		t.imag = o.real*plan->twiddle[k].imag + o.imag*plan->twiddle[k].real;
+		frameF[k].real = e.real + t.real;
+		frameF[k].imag = e.imag + t.imag;
+		if (k != n - k) {
+			frameF[n - k].real = e.real - t.real; 											/*Hermitian symmetry: X[n-k] = conj(E - W^k*O)*/
+			frameF[n - k].imag = t.imag - e.imag;
+		}
+	}
+
+}
+
+/* Single-precision version of separate(); */
+
+void separateFloat (const rfftPlan * const plan, complexf * const frameF) {
+
+	const unsigned int n = plan->half->n;
+
+	complexf a, b, e, o, t;
+
+	unsigned int k;
+
+	a = frameF[0];
+	frameF[0].real = a.real + a.imag;
+	frameF[0].imag = 0;
+	frameF[n].real = a.real - a.imag;
+	frameF[n].imag = 0;
+
+	for (k = 1; k <= n/2; k++) {
+		a = frameF[k];
+		b = frameF[n - k];
+		e.real = (a.real + b.real)/2;
+		e.imag = (a.imag - b.imag)/2;
+		o.real = (a.imag + b.imag)/2;
+		o.imag = (b.real - a.real)/2;
+		t.real = o.real*plan->twiddleFloat[k].real - o.imag*plan->twiddleFloat[k].imag;
+		t.imag = o.real*plan->twiddleFloat[k].imag + o.imag*plan->twiddleFloat[k].real;
+		frameF[k].real = e.real + t.real;
+		frameF[k].imag = e.imag + t.imag;
+		if (k != n - k) {
+			frameF[n - k].real = e.real - t.real;
+			frameF[n - k].imag = t.imag - e.imag;
+		}
+	}
+
+}
+
+/* Q15 version of separate();: the complex transform is scaled by 2/n (see transformQ15();), the real one is scaled by 1/n */
+
+void separateQ15 (const rfftPlan * const plan, complexq15 * const frameF) {
+
+	const unsigned int n = plan->half->n;
+
+	complexq15 a, b;
+	long long er, ei, sr, si, tr, ti; 														/*2E ('er', 'ei') and 2O ('sr', 'si') need 17 bits, and W*2O 33: 64 bits are needed*/
+
+	unsigned int k;
+
+	a = frameF[0];
+	frameF[0].real = saturate (((long long)a.real + a.imag + 1) >> 1);
+	frameF[0].imag = 0;
+	frameF[n].real = saturate (((long long)a.real - a.imag + 1) >> 1);
+	frameF[n].imag = 0;
+
+	for (k = 1; k <= n/2; k++) {
+		a = frameF[k];
+		b = frameF[n - k];
+		er = (long long)a.real + b.real; 													/*2E = A + conj(B)*/
+		ei = (long long)a.imag - b.imag;
+		sr = (long long)a.imag + b.imag; 													/*2O = -j*(A - conj(B))*/
+		si = (long long)b.real - a.real;
+		tr = sr*plan->twiddleQ15[k].real - si*plan->twiddleQ15[k].imag;
+		ti = sr*plan->twiddleQ15[k].imag + si*plan->twiddleQ15[k].real;
+		frameF[k].real = saturate ((er*32768 + tr + 65536) >> 17); 							/*(2E + 2W*O)/4, back to Q15*/
+		frameF[k].imag = saturate ((ei*32768 + ti + 65536) >> 17);
+		if (k != n - k) {
+			frameF[n - k].real = saturate ((er*32768 - tr + 65536) >> 17);
+			frameF[n - k].imag = saturate ((ti - ei*32768 + 65536) >> 17);
+		}
+	}
+
+}
+
+/* Split 'n' into radices 4, 2, 3 and 5, filling 'plan->factors' and 'plan->stages': return the remaining factor (1 if 'n' has no other prime factors) */
+
+unsigned int factorize (fftPlan * const plan, unsigned int n) {
+
+	const unsigned int radices[] = {4, 2, 3, 5};
+
+	unsigned int i;
+
+	plan->stages = 0;
+	for (i = 0; i < sizeof (radices)/sizeof (radices[0]); i++) {
+		while (n % radices[i] == 0 && plan->stages < MAX_FACTORS) {
+			plan->factors[plan->stages++] = radices[i];
+			n /= radices[i];
+		}
+	}
+
+	return n;
+
+}
+
+/* Evaluate the bit-reversal permutation and the twiddle factors of the radix-2 algorithm */
+
+STATUS initRadix2 (fftPlan * const plan) {
+
+	const unsigned int n = plan->n;
+
+	unsigned int m, h, q;
+
+	plan->bitrev = (unsigned int*)malloc (n*sizeof (unsigned int));
+	plan->twiddle = (complex*)malloc ((n > 1 ? n - 1 : 1)*sizeof (complex));
+	plan->twiddleSplit = splitCreate (n > 1 ? n - 1 : 1);
+	plan->twiddleFloat = (complexf*)malloc ((n > 1 ? n - 1 : 1)*sizeof (complexf));
+	plan->twiddleQ15 = (complexq15*)malloc ((n > 1 ? n - 1 : 1)*sizeof (complexq15));
+	if (plan->bitrev == NULL || plan->twiddle == NULL || plan->twiddleSplit == NULL || plan->twiddleFloat == NULL || plan->twiddleQ15 == NULL) return ERROR;
+
+	for (q = 0; q < n; q++) plan->bitrev[q] = reverseBits (q, plan->bits);
+
+	for (m = 2; m <= n; m <<= 1) { 															/*Twiddle factors are evaluated stage by stage, so that each stage reads them contiguously*/
+		h = m/2;
+		for (q = 0; q < h; q++) {
+			plan->twiddle[h - 1 + q].real = cos((2*PI*q)/m);
+			plan->twiddle[h - 1 + q].imag = -sin((2*PI*q)/m);
+			plan->twiddleFloat[h - 1 + q].real = (float)plan->twiddle[h - 1 + q].real;
+			plan->twiddleFloat[h - 1 + q].imag = (float)plan->twiddle[h - 1 + q].imag;
+			plan->twiddleQ15[h - 1 + q].real = toQ15 (plan->twiddle[h - 1 + q].real); 		/*1 is saturated to 1-2^-15*/
+			plan->twiddleQ15[h - 1 + q].imag = toQ15 (plan->twiddle[h - 1 + q].imag);
+		}
+	}
+
+	if (n > 1) splitFromComplex (plan->twiddle, plan->twiddleSplit, n - 1);
+
+	return OK;
+
+}
+
+/* Evaluate the digit-reversal permutation and the twiddle factors of the mixed-radix algorithm ('plan->factors' must be already filled) */
+
+STATUS initMixedRadix (fftPlan * const plan) {
+
+	const unsigned int n = plan->n;
+
+	unsigned int *position; 																/*'position[i]' is the sample that must be placed at 'i' before the first stage*/
+	unsigned int length, p, s, q, k;
+	complex *w;
+
+	plan->bitrev = (unsigned int*)malloc (n*sizeof (unsigned int));
+	plan->twiddle = (complex*)malloc (n*sizeof (complex));
+	position = (unsigned int*)malloc (n*sizeof (unsigned int));
+	if (plan->bitrev == NULL || plan->twiddle == NULL || position == NULL) {
+		free (position);
+		return ERROR;
+	}
+
+	position[0] = 0;
+	for (length = 1, s = 0; s < plan->stages; length *= p, s++) { 							/*A stage of radix 'p' merges 'p' transforms of 'length' samples taken with stride 'p'*/
+		p = plan->factors[s];
+		for (k = 0; k < length; k++) plan->bitrev[k] = position[k];
+		for (q = 0; q < p; q++) {
+			for (k = 0; k < length; k++) position[q*length + k] = q + p*plan->bitrev[k];
+		}
+	}
+	for (k = 0; k < n; k++) plan->bitrev[position[k]] = k;
+	free (position);
+
+	w = plan->twiddle;
+	for (length = 1, s = 0; s < plan->stages; length *= p, s++) { 							/*Twiddle factors exp(-j*2*PI*q*k/(p*length)), contiguous for each 'k'*/
+		p = plan->factors[s];
+		for (k = 0; k < length; k++) {
+			for (q = 1; q < p; q++, w++) {
+				w->real = cos((2*PI*q*k)/(p*length));
+				w->imag = -sin((2*PI*q*k)/(p*length));
+			}
+		}
+	}
+
+	return OK;
+
+}
+
+/* Evaluate the chirp and the transformed filter of the Bluestein algorithm, which turns the transform into a radix-2 circular convolution */
+
+STATUS initBluestein (fftPlan * const plan) {
+
+	const unsigned int n = plan->n;
+
+	unsigned long long square;
+	unsigned int k;
+
+	for (plan->m = 1; plan->m < 2*n - 1; plan->m <<= 1);
+
+	plan->inner = fftCreate_ (plan->m, plan->kernel);
+	plan->chirp = (complex*)malloc (n*sizeof (complex));
+	plan->filter = (complex*)malloc (plan->m*sizeof (complex));
+	plan->scratch = (complex*)malloc (plan->m*sizeof (complex));
+	if (plan->inner == NULL || plan->chirp == NULL || plan->filter == NULL || plan->scratch == NULL) return ERROR;
+
+	for (k = 0; k < n; k++) {
+		square = ((unsigned long long)k*k) % (2*n); 										/*exp(-j*PI*k^2/n) has period 2n in k^2: reducing it keeps the argument accurate*/
+		plan->chirp[k].real = cos((PI*square)/n);
+		plan->chirp[k].imag = -sin((PI*square)/n);
+	}
+
+	for (k = 0; k < plan->m; k++) { 														/*Conjugate chirp, wrapped around to make the convolution circular...*/
+		plan->scratch[k].real = 0;
+		plan->scratch[k].imag = 0;
+	}
+	for (k = 0; k < n; k++) {
+		plan->scratch[k].real = plan->chirp[k].real;
+		plan->scratch[k].imag = -plan->chirp[k].imag;
+		if (k > 0) plan->scratch[plan->m - k] = plan->scratch[k];
+	}
+
+	scatter (plan->inner, plan->scratch, plan->filter); 									/*...and transformed, including the 1/m factor of the inverse transform*/
+	butterflies (plan->inner, plan->filter);
+	for (k = 0; k < plan->m; k++) {
+		plan->filter[k].real /= plan->m;
+		plan->filter[k].imag /= plan->m;
+	}
+
+	return OK;
+
+}
+
+/* Allocate a plan of length 'n' using 'kernel', choose its algorithm and evaluate its tables */
+
+fftPlan* allocPlan (const unsigned int n, const dspKernel * const kernel) {
+
+	fftPlan * const plan = (fftPlan*)calloc (1, sizeof (fftPlan)); 							/*All tables start as NULL*/
+
+	const int bits = log2n (n);
+
+	STATUS st;
+
+	if (plan == NULL) return NULL;
+
+	plan->n = n;
+	plan->refs = 1;
+	plan->kernel = kernel;
+
+	if (bits >= 0) { 																		/*Powers of 2 use the vectorized radix-2 algorithm...*/
+		plan->algorithm = FFT_RADIX2;
+		plan->bits = (unsigned int)bits;
+		st = initRadix2 (plan);
+	}
+	else if (factorize (plan, n) == 1) { 													/*...lengths with prime factors 2, 3 and 5 only the mixed-radix one...*/
+		plan->algorithm = FFT_MIXED_RADIX;
+		st = initMixedRadix (plan);
+	}
+	else { 																					/*...and all the other lengths the Bluestein one*/
+		plan->algorithm = FFT_BLUESTEIN;
+		st = initBluestein (plan);
+	}
+
+	if (st == ERROR) {
+		freePlan (plan);
+		return NULL;
+	}
+
+	return plan;
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the algebraic definition, and write them in 'frameF' */
+
+void sft (const double * const frameT, complex * const frameF, const unsigned int n) {
+
+	complex sum;
+
+	unsigned int p, q;
+
+	for (p = 0; p < n; p++) {
+		sum.real = 0;
+		sum.imag = 0;
+		for (q = 0; q < n; q++) {
+			sum.real += frameT[q]*cos((2*PI*p*q)/n);
+			sum.imag -= frameT[q]*sin((2*PI*p*q)/n);
+		}
+		frameF[p] = sum;
+	}
+
+}
+
+/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the in-place iterative radix-2 algorithm, and write them in 'frameF' */
+
+STATUS fft (const double * const frameT, complex * const frameF, const unsigned int n) {
+
+	const int bits = log2n (n);
+
+	complex w, t;
+	complex *a, *b;
+
+	unsigned int m, h, p, q;
+
+	if (bits < 0) return NOT_POWER_OF_2;
+
+	for (q = 0; q < n; q++) { 																/*Bit-reversal permutation: real samples are scattered into 'frameF'*/
+		p = reverseBits (q, (unsigned int)bits);
+		frameF[p].real = frameT[q];
+		frameF[p].imag = 0;
+	}
+
+	for (m = 2; m <= n; m <<= 1) { 															/*Butterflies: 'm' is the length of the sub-transforms merged at this stage*/
+		h = m/2;
+		for (p = 0; p < h; p++) {
+			w.real = cos((2*PI*p)/m); 														/*Twiddle factor shared by all butterflies with the same offset 'p'*/
+			w.imag = -sin((2*PI*p)/m);
+			for (q = p; q < n; q += m) {
+				a = &frameF[q];
+				b = &frameF[q + h];
+				t.real = b->real*w.real - b->imag*w.imag;
+				t.imag = b->real*w.imag + b->imag*w.real;
+				b->real = a->real - t.real;
+				b->imag = a->imag - t.imag;
+				a->real += t.real;
+				a->imag += t.imag;
+			}
+		}
+	}
+
+	return OK;
+
+}
+
+/* Return a plan for transforms of length 'n' evaluated by 'kernel', computing its tables if no task has created it yet */
+
+fftPlan* fftCreate_ (const unsigned int n, const dspKernel * const kernel) {
+
+	fftPlan *plan, *cached;
+
+	unsigned int i;
+
+	if (n == 0 || kernel == NULL) return NULL;
+
+	taskLock(); 																			/*The cache is shared among tasks: no preemption while it's accessed*/
+	cached = findPlan (n, kernel);
+	taskUnlock();
+
+	if (cached != NULL) return cached;
+
+	plan = allocPlan (n, kernel); 															/*Tables are evaluated with preemption enabled...*/
+	if (plan == NULL) return NULL;
+	if (plan->scratch != NULL) return plan; 												/*Bluestein work buffers belong to a single task: never cached*/
+
+	taskLock();
+	cached = findPlan (n, kernel); 															/*...so another task may have cached the same plan in the meanwhile*/
+	if (cached == NULL) {
+		for (i = 0; i < MAX_PLANS && plans[i] != NULL; i++);
+		if (i < MAX_PLANS) plans[i] = plan; 												/*If the cache is full, the plan is simply not shared*/
+	}
+	taskUnlock();
+
+	if (cached != NULL) {
+		freePlan (plan);
+		return cached;
+	}
+
+	return plan;
+
+}
+
+/* Overload of the previous routine using the kernels of the most powerful instruction set extension supported by the processor */
+
+fftPlan* fftCreate (const unsigned int n) {
+
+	return fftCreate_ (n, kernelSelect());
+
+}
+
+/* Evaluate the Fourier Transform of 'plan->n' samples contained in 'frameT' and write them in 'frameF' */
+
+void fftExecute (const fftPlan * const plan, const double * const frameT, complex * const frameF) {
+
+	transform (plan, frameT, NULL, 1, frameF);
+
+}
+
+/* General form of fftExecute();: transform complex values read from 'real' and 'imag' every 'stride' values */
+
+void fftExecute_ (const fftPlan * const plan, const double * const real, const double * const imag, const unsigned int stride, complex * const frameF) {
+
+	transform (plan, real, imag, stride, frameF);
+
+}
+
+/* Evaluate the inverse Fourier Transform of 'plan->n' bins contained in 'frameF' and write the 'plan->n' complex samples in 'frameT' */
+
+void ifftExecute (const fftPlan * const plan, const complex * const frameF, complex * const frameT) {
+
+	const double scale = 1.0/plan->n;
+
+	double real;
+
+	unsigned int q;
+
+	transform (plan, &frameF->imag, &frameF->real, 2, frameT); 								/*fft(swap(X)) = swap(n*ifft(X)), where swap(a + j*b) = b + j*a*/
+
+	for (q = 0; q < plan->n; q++) {
+		real = frameT[q].imag*scale;
+		frameT[q].imag = frameT[q].real*scale;
+		frameT[q].real = real;
+	}
+
+}
+
+/* Release a plan obtained by fftCreate(); */
+
+void fftDestroy (fftPlan * const plan) {
+
+	boolean last;
+
+	unsigned int i;
+
+	taskLock();
+	last = (--plan->refs == 0);
+	if (last) {
+		for (i = 0; i < MAX_PLANS; i++) {
+			if (plans[i] == plan) plans[i] = NULL;
+		}
+	}
+	taskUnlock();
+
+	if (last) freePlan (plan);
+
+}
+
+/* Return a plan for transforms of 'n' real samples */
+
+rfftPlan* rfftCreate (const unsigned int n) {
+
+	rfftPlan *plan;
+
+	unsigned int k;
+
+	if (n < 2 || n % 2 != 0) return NULL;
+
+	plan = (rfftPlan*)malloc (sizeof (rfftPlan));
+	if (plan == NULL) return NULL;
+
+	plan->n = n;
+	plan->half = fftCreate (n/2);
+	plan->twiddle = (complex*)malloc ((n/4 + 1)*sizeof (complex));
+	plan->twiddleFloat = (complexf*)malloc ((n/4 + 1)*sizeof (complexf));
+	plan->twiddleQ15 = (complexq15*)malloc ((n/4 + 1)*sizeof (complexq15));
+
+	if (plan->half == NULL || plan->twiddle == NULL || plan->twiddleFloat == NULL || plan->twiddleQ15 == NULL) {
+		if (plan->half != NULL) fftDestroy (plan->half);
+		free (plan->twiddle);
+		free (plan->twiddleFloat);
+		free (plan->twiddleQ15);
+		free (plan);
+		return NULL;
+	}
+
+	for (k = 0; k <= n/4; k++) {
+		plan->twiddle[k].real = cos((2*PI*k)/n);
+		plan->twiddle[k].imag = -sin((2*PI*k)/n);
+		plan->twiddleFloat[k].real = (float)plan->twiddle[k].real;
+		plan->twiddleFloat[k].imag = (float)plan->twiddle[k].imag;
+		plan->twiddleQ15[k].real = toQ15 (plan->twiddle[k].real);
+		plan->twiddleQ15[k].imag = toQ15 (plan->twiddle[k].imag);
+	}
+
+	return plan;
+
+}
+
+/* Evaluate the Fourier Transform of 'plan->n' real samples contained in 'frameT', and write the 'plan->n/2+1' non-redundant bins in 'frameF' */
+
+void rfftExecute (const rfftPlan * const plan, const double * const frameT, complex * const frameF) {
+
+	transform (plan->half, frameT, frameT + 1, 2, frameF); 									/*Even samples become real parts and odd samples imaginary parts of a complex transform*/
+
+	separate (plan, frameF);
+
+}
+
+/* Evaluate the inverse Fourier Transform of the 'plan->n/2+1' non-redundant bins contained in 'frameF' and write the 'plan->n' real samples in 'frameT' */
+
+void irfftExecute (const rfftPlan * const plan, complex * const frameF, double * const frameT) {
+
+	const unsigned int n = plan->half->n;
+	const double scale = 1.0/n;
+
+	complex * const z = (complex*)frameT; 													/*Even samples are real parts and odd samples imaginary parts of 'z'*/
+	complex a, b, e, o, t;
+	double real;
+
+	unsigned int k;
+
+	a = frameF[0];
+	b = frameF[n];
+	frameF[0].real = (a.real + b.real)/2; 													/*Z[0] = E[0] + j*O[0], both real*/
+	frameF[0].imag = (a.real - b.real)/2;
+
+	for (k = 1; k <= n/2; k++) { 															/*Inverse of separate();: Z[k] = E[k] + j*O[k], with E and O recovered from X[k] and X[n-k]*/
+		a = frameF[k];
+		b = frameF[n - k];
+		e.real = (a.real + b.real)/2; 														/*E = (A + conj(B))/2*/
+		e.imag = (a.imag - b.imag)/2;
+		t.real = (a.real - b.real)/2; 														/*W^k*O = (A - conj(B))/2*/
+		t.imag = (a.imag + b.imag)/2;
+		o.real = t.real*plan->twiddle[k].real + t.imag*plan->twiddle[k].imag; 				/*O = conj(W^k)*(W^k*O)*/
+		o.imag = t.imag*plan->twiddle[k].real - t.real*plan->twiddle[k].imag;
+		frameF[k].real = e.real - o.imag;
+		frameF[k].imag = e.imag + o.real;
+		if (k != n - k) {
+			frameF[n - k].real = e.real + o.imag; 											/*E[n-k] = conj(E[k]) and O[n-k] = conj(O[k])*/
+			frameF[n - k].imag = o.real - e.imag;
+		}
+	}
+
+	transform (plan->half, &frameF->imag, &frameF->real, 2, z); 							/*Inverse transform of length 'n', as in ifftExecute();*/
+
+	for (k = 0; k < n; k++) {
+		real = z[k].imag*scale;
+		z[k].imag = z[k].real*scale;
+		z[k].real = real;
+	}
+
+}
+
+/* Release a plan obtained by rfftCreate(); */
+
+void rfftDestroy (rfftPlan * const plan) {
+
+	fftDestroy (plan->half);
+	free (plan->twiddle);
+	free (plan->twiddleFloat);
+	free (plan->twiddleQ15);
+	free (plan);
+
+}
+
+/* Single-precision version of fftExecute(); */
+
+STATUS fftExecuteFloat (const fftPlan * const plan, const float * const frameT, complexf * const frameF) {
+
+	if (plan->algorithm != FFT_RADIX2) return NOT_POWER_OF_2;
+
+	transformFloat (plan, frameT, NULL, 1, frameF);
+
+	return OK;
+
+}
+
+/* Q15 version of fftExecute(); */
+
+STATUS fftExecuteQ15 (const fftPlan * const plan, const q15 * const frameT, complexq15 * const frameF) {
+
+	if (plan->algorithm != FFT_RADIX2) return NOT_POWER_OF_2;
+
+	transformQ15 (plan, frameT, NULL, 1, frameF);
+
+	return OK;
+
+}
+
+/* Single-precision version of rfftExecute(); */
+
+STATUS rfftExecuteFloat (const rfftPlan * const plan, const float * const frameT, complexf * const frameF) {
+
+	if (plan->half->algorithm != FFT_RADIX2) return NOT_POWER_OF_2;
+
+	transformFloat (plan->half, frameT, frameT + 1, 2, frameF);
+	separateFloat (plan, frameF);
+
+	return OK;
+
+}
+
+/* Q15 version of rfftExecute(); */
+
+STATUS rfftExecuteQ15 (const rfftPlan * const plan, const q15 * const frameT, complexq15 * const frameF) {
+
+	if (plan->half->algorithm != FFT_RADIX2) return NOT_POWER_OF_2;
+
+	transformQ15 (plan->half, frameT, frameT + 1, 2, frameF);
+	separateQ15 (plan, frameF);
+
+	return OK;
+
+}
+
+/* Evaluate the Fourier Transform of 'plan->n' real samples contained in 'frameT', whose format is 'format', and write the bins in 'frameF' */
+
+STATUS rfftExecute_ (const rfftPlan * const plan, const precision format, const void * const frameT, void * const frameF) {
+
+	switch (format) {
+		case (PRECISION_FLOAT):
+			return rfftExecuteFloat (plan, (const float*)frameT, (complexf*)frameF);
+		case (PRECISION_Q15):
+			return rfftExecuteQ15 (plan, (const q15*)frameT, (complexq15*)frameF);
+		default:
+			rfftExecute (plan, (const double*)frameT, (complex*)frameF);
+			return OK;
+	}
+
+}
+
+/* Convert 'n' samples from 'frameT' into the single-precision frame 'frameT_' */
+
+void floatFromReal (const double * const frameT, float * const frameT_, const unsigned int n) {
+
+	unsigned int q;
+	for (q = 0; q < n; q++) frameT_[q] = (float)frameT[q];
+
+}
+
+/* Convert 'n' samples from 'frameT' into the Q15 frame 'frameT_', dividing them by 'scale' */
+
+void q15FromReal (const double * const frameT, q15 * const frameT_, const unsigned int n, const double scale) {
+
+	unsigned int q;
+	for (q = 0; q < n; q++) frameT_[q] = toQ15 (frameT[q]/scale);
+
+}
+
+/* Convert 'n' single-precision complex values from 'frameF_' into 'frameF' */
+
+void complexFromFloat (const complexf * const frameF_, complex * const frameF, const unsigned int n) {
+
+	unsigned int k;
+	for (k = 0; k < n; k++) {
+		frameF[k].real = frameF_[k].real;
+		frameF[k].imag = frameF_[k].imag;
+	}
+
+}
+
+/* Convert 'n' Q15 complex values from 'frameF_' into 'frameF', multiplying them by 'gain' */
+
+void complexFromQ15 (const complexq15 * const frameF_, complex * const frameF, const unsigned int n, const double gain) {
+
+	unsigned int k;
+	for (k = 0; k < n; k++) {
+		frameF[k].real = (frameF_[k].real/Q15_ONE)*gain;
+		frameF[k].imag = (frameF_[k].imag/Q15_ONE)*gain;
+	}
+
+}
+
+/* Return a batch for transforms of 'channels' frames of 'n' real samples each */
+
+fftBatch* fftBatchCreate (const unsigned int n, const unsigned int channels) {
+
+	fftBatch *batch;
+
+	if (channels == 0) return NULL;
+
+	batch = (fftBatch*)malloc (sizeof (fftBatch));
+	if (batch == NULL) return NULL;
+
+	batch->n = n;
+	batch->channels = channels;
+	batch->plan = rfftCreate (n);
+	batch->data = (batch->plan != NULL) ? splitCreate ((n/2)*BATCH_LANES) : NULL;
+
+	if (batch->data == NULL) {
+		if (batch->plan != NULL) rfftDestroy (batch->plan);
+		free (batch);
+		return NULL;
+	}
+
+	return batch;
+
+}
+
+/* Evaluate the Fourier Transform of 'batch->channels' real frames */
+
+void fftBatchExecute (const fftBatch * const batch, const double * const frameT, const unsigned int stride, const unsigned int distance,
+	complex * const frameF) {
+
+	const fftPlan * const half = batch->plan->half;
+	const unsigned int h = half->n;
+	double * const real = batch->data->real;
+	double * const imag = batch->data->imag;
+
+	const double *x;
+	const double *in[BATCH_LANES];
+	complex *out;
+	complex *outs[BATCH_LANES];
+	unsigned int width, row, a;
+
+	unsigned int first, c, q, m, g;
+
+	if (half->algorithm != FFT_RADIX2) { 													/*Other algorithms transform the frames one by one*/
+		for (c = 0; c < batch->channels; c++) {
+			x = frameT + c*distance;
+			out = frameF + c*(h + 1);
+			transform (half, x, x + stride, 2*stride, out);
+			separate (batch->plan, out);
+		}
+		return;
+	}
+
+	for (first = 0; first < batch->channels; first += BATCH_LANES) { 						/*Frames are processed in groups, whose rows fill a cache line*/
+		width = (batch->channels - first < BATCH_LANES) ? batch->channels - first : BATCH_LANES;
+		for (c = 0; c < width; c++) {
+			in[c] = frameT + (first + c)*distance;
+			outs[c] = frameF + (first + c)*(h + 1);
+		}
+
+		for (q = 0; q < h; q++) { 															/*Even samples become real parts and odd samples imaginary parts, scattered into bit-reversed rows...*/
+			row = half->bitrev[q]*BATCH_LANES;
+			for (c = 0; c < width; c++) {
+				real[row + c] = in[c][(2*q)*stride];
+				imag[row + c] = in[c][(2*q + 1)*stride];
+			}
+			for (c = width; c < BATCH_LANES; c++) { 										/*...with null values for the frames missing in the last group*/
+				real[row + c] = 0;
+				imag[row + c] = 0;
+			}
+		}
+
+		for (m = 2; m <= h; m <<= 1) { 														/*Same stages of butterflies();, but each butterfly processes a whole row*/
+			for (g = 0; g < h; g += m) {
+				a = g*BATCH_LANES;
+				half->kernel->butterflyBatch (real + a, imag + a, real + a + (m/2)*BATCH_LANES, imag + a + (m/2)*BATCH_LANES, &half->twiddle[m/2 - 1], m/2,
+					BATCH_LANES);
+			}
+		}
+
+		for (q = 0; q < h; q++) { 															/*Rows are gathered back into the frames...*/
+			row = q*BATCH_LANES;
+			for (c = 0; c < width; c++) {
+				outs[c][q].real = real[row + c];
+				outs[c][q].imag = imag[row + c];
+			}
+		}
+		for (c = 0; c < width; c++) separate (batch->plan, outs[c]); 						/*...and separated into the bins of the real transforms*/
+	}
+
+}
+
+/* Release a batch obtained by fftBatchCreate(); */
+
+void fftBatchDestroy (fftBatch * const batch) {
+
+	rfftDestroy (batch->plan);
+	splitDestroy (batch->data);
+	free (batch);
+
+}
+
+/* Allocate a split-complex frame of 'n' values */
+
+splitFrame* splitCreate (const unsigned int n) {
+
+	splitFrame * const frame = (splitFrame*)malloc (sizeof (splitFrame));
+
+	if (frame == NULL) return NULL;
+
+	frame->n = n;
+	frame->real = (double*)memalign (SPLIT_ALIGNMENT, n*sizeof (double));
+	frame->imag = (double*)memalign (SPLIT_ALIGNMENT, n*sizeof (double));
+
+	if (frame->real == NULL || frame->imag == NULL) {
+		splitDestroy (frame);
+		return NULL;
+	}
+
+	return frame;
+
+}
+
+/* Free a split-complex frame obtained by splitCreate(); */
+
+void splitDestroy (splitFrame * const frame) {
+
+	free (frame->real);
+	free (frame->imag);
+	free (frame);
+
+}
+
+/* Convert 'n' complex values from 'frameF' into the split-complex frame 'frameS' */
+
+void splitFromComplex (const complex * const frameF, splitFrame * const frameS, const unsigned int n) {
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+		frameS->real[index] = frameF[index].real;
+		frameS->imag[index] = frameF[index].imag;
+	}
+
+}
+
+/* Convert 'n' values from the split-complex frame 'frameS' into 'frameF' */
+
+void complexFromSplit (const splitFrame * const frameS, complex * const frameF, const unsigned int n) {
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+		frameF[index].real = frameS->real[index];
+		frameF[index].imag = frameS->imag[index];
+	}
+
+}
+
+/* Split-complex version of fftExecute(); */
+
+void fftExecuteSplit (const fftPlan * const plan, const double * const frameT, splitFrame * const frameS) {
+
+	transformSplit (plan, frameT, NULL, 1, frameS);
+
+}
+
+/* Split-complex version of rfftExecute(); */
+
+void rfftExecuteSplit (const rfftPlan * const plan, const double * const frameT, splitFrame * const frameS) {
+
+	const unsigned int n = plan->half->n;
+	double * const real = frameS->real;
+	double * const imag = frameS->imag;
+
+	double ar, ai, br, bi, er, ei, xr, xi, tr, ti;
+
+	unsigned int k;
+
+	transformSplit (plan->half, frameT, frameT + 1, 2, frameS); 							/*Even samples become real parts and odd samples imaginary parts of a complex transform*/
+
+	ar = real[0];
+	ai = imag[0];
+	real[0] = ar + ai;
+	imag[0] = 0;
+	real[n] = ar - ai;
+	imag[n] = 0;
+
+	for (k = 1; k <= n/2; k++) { 															/*See rfftExecute(); for details*/
+		ar = real[k];
+		ai = imag[k];
+		br = real[n - k];
+		bi = imag[n - k];
+		er = (ar + br)/2;
+		ei = (ai - bi)/2;
+		xr = (ai + bi)/2;
+		xi = (br - ar)/2;
+		tr = xr*plan->twiddle[k].real - xi*plan->twiddle[k].imag;
+		ti = xr*plan->twiddle[k].imag + xi*plan->twiddle[k].real;
+		real[k] = er + tr;
+		imag[k] = ei + ti;
+		if (k != n - k) {
+			real[n - k] = er - tr;
+			imag[n - k] = ti - ei;
+		}
+	}
+
+}
@@ -1,35 +1,309 @@
-/*
- * This library provides functionalities related to digital signal processing (DSP)
- * Author: Alessandro Trifoglio
- * Last revision: 21/12/2016
- */
-
-#ifndef DIGITALPROCESS_H
-#define DIGITALPROCESS_H
-
-/* Project root library */
-
-#include "root.h"
-
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Complex type */
-
-typedef struct complex {
-
-	double real;
-	double imag;
-
-} complex;
-
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- DSP -------------------------------------------------------------------------- */
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the algebraic definition, and write them in 'frameF' */
-
-void sft (const double * const frameT, complex * const frameF, const unsigned int n);
-
+/*
+ * This library provides functionalities related to digital signal processing (DSP)
+ * Author: Alessandro Trifoglio
+ * Last revision: 21/12/2016
+ */
+
+#ifndef DIGITALPROCESS_H
+#define DIGITALPROCESS_H
+
+/* Project root library */
+
+#include "root.h"
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Messages (STATUS) */
+
+#define NOT_POWER_OF_2 								0xb192c0cc
+
+/* Alignment (bytes) of the arrays of split-complex frames: a cache line, that is also the width of AVX-512 registers */
+
+#define SPLIT_ALIGNMENT 							64
+
+/* Number of frames transformed together by batches: their values with the same index fill an aligned block of SPLIT_ALIGNMENT bytes */
+
+#define BATCH_LANES 								(SPLIT_ALIGNMENT/sizeof (double))
+
+/* Maximum number of stages of the mixed-radix algorithm (enough for any 32-bit length) */
+
+#define MAX_FACTORS 								32
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Complex type */
+
+typedef struct complex {
+
+	double real;
+	double imag;
+
+} complex;
+
+/* Single-precision complex type */
+
+typedef struct complexf {
+
+	float real;
+	float imag;
+
+} complexf;
+
+/* Q15 fixed-point type: 16-bit signed values representing [-1, 1) with a resolution of 2^-15 */
+
+typedef short q15;
+
+/* Q15 complex type */
+
+typedef struct complexq15 {
+
+	q15 real;
+	q15 imag;
+
+} complexq15;
+
+/* Numeric formats of a processing pipeline */
+
+typedef enum precision {
+	PRECISION_DOUBLE = 0,
+	PRECISION_FLOAT = 1,
+	PRECISION_Q15 = 2
+} precision;
+
+/* Split-complex frame: real and imaginary parts are kept in separate arrays (aligned to SPLIT_ALIGNMENT bytes), so that vectorized kernels need no shuffles
+ * and consumers of a single part don't load the other one */
+
+typedef struct splitFrame {
+
+	unsigned int n; 								/*Number of complex values*/
+
+	double *real; 									/*Real parts*/
+	double *imag; 									/*Imaginary parts*/
+
+} splitFrame;
+
+/* Algorithms used by plans: radix-2 for powers of 2, mixed-radix (2, 3, 4, 5) for lengths without other prime factors, Bluestein (chirp-z) otherwise */
+
+typedef enum fftAlgorithm {
+	FFT_RADIX2 = 0,
+	FFT_MIXED_RADIX = 1,
+	FFT_BLUESTEIN = 2
+} fftAlgorithm;
+
+/* Computational kernels (see dspKernel.h) */
+
+struct dspKernel;
+
+/* Plan for the Fourier Transform of frames with a given length: its tables are evaluated once by fftCreate(); and shared by all the tasks using that length
+ * (Bluestein plans excepted: they have a work buffer, so each fftCreate(); returns a plan of its own) */
+
+typedef struct fftPlan {
+
+	unsigned int n; 								/*Length of the transform*/
+	fftAlgorithm algorithm; 						/*Algorithm chosen for 'n'*/
+	unsigned int bits; 								/*Base-2 logarithm of 'n' (radix-2 only)*/
+
+	unsigned int refs; 								/*Number of fftCreate(); not yet balanced by fftDestroy();*/
+
+	unsigned int *bitrev; 							/*Bit-reversal (digit-reversal for mixed-radix) permutation: sample 'q' goes to 'bitrev[q]'*/
+	complex *twiddle; 								/*Twiddle factors: the radix-2 stage merging transforms of length 'm' uses 'twiddle[m/2-1]' up to 'twiddle[m-2]'*/
+	splitFrame *twiddleSplit; 						/*The same twiddle factors, in split-complex layout (radix-2 only)*/
+	complexf *twiddleFloat; 						/*The same twiddle factors, in single precision (radix-2 only)*/
+	complexq15 *twiddleQ15; 						/*The same twiddle factors, in Q15 format (radix-2 only)*/
+
+	unsigned int factors[MAX_FACTORS]; 				/*Radices of the stages, from the first to the last (mixed-radix only)*/
+	unsigned int stages; 							/*Number of stages (mixed-radix only)*/
+
+	unsigned int m; 								/*Length of the circular convolution: power of 2 not less than 2n-1 (Bluestein only)*/
+	struct fftPlan *inner; 							/*Shared radix-2 plan of length 'm' (Bluestein only)*/
+	complex *chirp; 								/*Chirp exp(-j*PI*k^2/n), for 0<=k<n (Bluestein only)*/
+	complex *filter; 								/*Transform of the conjugate chirp, divided by 'm' (Bluestein only)*/
+
+	complex *scratch; 								/*Work buffer of length 'm' (Bluestein only: never shared)*/
+
+	const struct dspKernel *kernel; 				/*Kernels used to evaluate butterflies*/
+
+} fftPlan;
+
+/* Plan for the Fourier Transform of real frames with a given length 'n': samples are packed in pairs into a complex transform of length 'n/2' */
+
+typedef struct rfftPlan {
+
+	unsigned int n; 								/*Length of the transform (even)*/
+
+	fftPlan *half; 									/*Shared plan of the complex transform of length 'n/2'*/
+	complex *twiddle; 								/*Post-processing twiddle factors: 'twiddle[k]' is exp(-j*2*PI*k/n), for 0<=k<=n/4*/
+	complexf *twiddleFloat; 						/*The same twiddle factors, in single precision*/
+	complexq15 *twiddleQ15; 						/*The same twiddle factors, in Q15 format*/
+
+} rfftPlan;
+
+/* Batch of real frames transformed together, BATCH_LANES at a time: values with the same index of those frames are interleaved, so that each butterfly loads
+ * its twiddle factor once and applies it to a whole row of frames with vector instructions */
+
+typedef struct fftBatch {
+
+	unsigned int n; 								/*Length of each transform (even)*/
+	unsigned int channels; 							/*Number of frames transformed by each call*/
+
+	rfftPlan *plan; 								/*Plan of the real transform of length 'n'*/
+	splitFrame *data; 								/*Work area of 'n/2' rows of BATCH_LANES values: row 'q' holds the complex value 'q' of the frames in progress*/
+
+} fftBatch;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- DSP -------------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the algebraic definition, and write them in 'frameF' */
+
+void sft (const double * const frameT, complex * const frameF, const unsigned int n);
+
+/* Evaluate the Fourier Transform of 'n' samples contained in 'frameT' using the in-place iterative radix-2 algorithm, and write them in 'frameF'. 'n' must be
+ * a power of 2, otherwise NOT_POWER_OF_2 is returned and 'frameF' is left untouched. Results are the same of sft(); up to rounding errors */
+
+STATUS fft (const double * const frameT, complex * const frameF, const unsigned int n);
+
+/* Return a plan for transforms of length 'n' evaluated by 'kernel', computing its tables if no task has created it yet; otherwise, the cached plan is shared.
+ * Any length is transformed in O(n*log(n)) time: powers of 2 by the radix-2 algorithm, lengths whose prime factors are 2, 3 and 5 by the mixed-radix one,
+ * the others by the Bluestein one (through a radix-2 transform of length at least 2n-1, so they are the slowest). Vectorized kernels are used by radix-2
+ * stages only. Bluestein plans are never shared, since they carry a work buffer: each call returns a new one (sharing its inner radix-2 plan), to be used
+ * by a single task at a time, so that tasks never wait for each other. Call it outside the periodic activity (for instance in the initial one). NULL is
+ * returned if 'n' is 0 or memory is exhausted */
+
+fftPlan* fftCreate_ (const unsigned int n, const struct dspKernel * const kernel);
+
+/* Overload of the previous routine using the kernels of the most powerful instruction set extension supported by the processor (see kernelSelect();) */
+
+fftPlan* fftCreate (const unsigned int n);
+
+/* Evaluate the Fourier Transform of 'plan->n' samples contained in 'frameT' and write them in 'frameF'. Neither trigonometric functions nor allocations are used */
+
+void fftExecute (const fftPlan * const plan, const double * const frameT, complex * const frameF);
+
+/* General form of fftExecute();: the 'plan->n' input values are complex, with real parts read from 'real' and imaginary parts from 'imag' (NULL for real
+ * input), both every 'stride' values. Strided input lets transforms run on the columns of a matrix, or on interleaved channels, without copying them */
+
+void fftExecute_ (const fftPlan * const plan, const double * const real, const double * const imag, const unsigned int stride, complex * const frameF);
+
+/* Evaluate the inverse Fourier Transform of 'plan->n' bins contained in 'frameF' and write the 'plan->n' complex samples in 'frameT', scaled by 1/n so
+ * that ifftExecute(); undoes fftExecute();. It runs the forward plan on the bins with real and imaginary parts swapped: no other plan is needed */
+
+void ifftExecute (const fftPlan * const plan, const complex * const frameF, complex * const frameT);
+
+/* Release a plan obtained by fftCreate();: its tables are freed when the last task using it has released it */
+
+void fftDestroy (fftPlan * const plan);
+
+/* Return a plan for transforms of 'n' real samples: 'n' must be even, otherwise NULL is returned */
+
+rfftPlan* rfftCreate (const unsigned int n);
+
+/* Evaluate the Fourier Transform of 'plan->n' real samples contained in 'frameT', and write the 'plan->n/2+1' non-redundant bins in 'frameF' (the others
+ * follow from the Hermitian symmetry frameF[n-k] = conj(frameF[k])). 'frameF' must have room for 'plan->n/2+1' complex values */
+
+void rfftExecute (const rfftPlan * const plan, const double * const frameT, complex * const frameF);
+
+/* Evaluate the inverse Fourier Transform of the 'plan->n/2+1' non-redundant bins contained in 'frameF' (the spectrum of a real signal, as written by
+ * rfftExecute();) and write the 'plan->n' real samples in 'frameT', scaled by 1/n. The bins are merged in place into the spectrum of a complex transform of
+ * length 'n/2': 'frameF' is overwritten */
+
+void irfftExecute (const rfftPlan * const plan, complex * const frameF, double * const frameT);
+
+/* Release a plan obtained by rfftCreate(); */
+
+void rfftDestroy (rfftPlan * const plan);
+
+/* Single-precision version of fftExecute();: 'plan->n' must be a power of 2, otherwise NOT_POWER_OF_2 is returned and 'frameF' is left untouched. Compared
+ * with the double-precision results, the maximum error of a bin is below 2^-24*log2(n) times the largest bin magnitude (each stage adds a rounding error of
+ * float, 2^-24, to the values it propagates). Frames and twiddle factors take half the memory */
+
+STATUS fftExecuteFloat (const fftPlan * const plan, const float * const frameT, complexf * const frameF);
+
+/* Q15 version of fftExecute();: 'plan->n' must be a power of 2, otherwise NOT_POWER_OF_2 is returned and 'frameF' is left untouched. Each stage halves its
+ * results so that they never overflow: bins are scaled by 1/n, and 'frameF[k]' represents X[k]/n. Compared with the double-precision results (scaled the
+ * same way), the maximum error of a bin is below 3 LSB (2^-15) for n up to 65536: halving also damps the rounding errors of the previous stages, so that
+ * they grow slowly with n. On the other hand, the scaling costs resolution: the relative error of a bin of magnitude |X| is about n*2^-15/|X| */
+
+STATUS fftExecuteQ15 (const fftPlan * const plan, const q15 * const frameT, complexq15 * const frameF);
+
+/* Single-precision version of rfftExecute();: 'plan->n/2' must be a power of 2, otherwise NOT_POWER_OF_2 is returned. Error bounds are the ones of
+ * fftExecuteFloat(); */
+
+STATUS rfftExecuteFloat (const rfftPlan * const plan, const float * const frameT, complexf * const frameF);
+
+/* Q15 version of rfftExecute();: 'plan->n/2' must be a power of 2, otherwise NOT_POWER_OF_2 is returned. As for fftExecuteQ15();, 'frameF[k]' represents
+ * X[k]/n, with a maximum error below 3 LSB for n up to 65536 */
+
+STATUS rfftExecuteQ15 (const rfftPlan * const plan, const q15 * const frameT, complexq15 * const frameF);
+
+/* Evaluate the Fourier Transform of 'plan->n' real samples contained in 'frameT', whose format is 'format', and write the 'plan->n/2+1' non-redundant bins
+ * in 'frameF' in the same format (complex, complexf or complexq15 values): it calls rfftExecute();, rfftExecuteFloat(); or rfftExecuteQ15();, so that
+ * the precision of a pipeline is chosen by a single parameter */
+
+STATUS rfftExecute_ (const rfftPlan * const plan, const precision format, const void * const frameT, void * const frameF);
+
+/* Convert 'n' samples from 'frameT' into the single-precision frame 'frameT_' */
+
+void floatFromReal (const double * const frameT, float * const frameT_, const unsigned int n);
+
+/* Convert 'n' samples from 'frameT' into the Q15 frame 'frameT_': samples are divided by 'scale' (the full-scale value of the input, mapped to 1), then
+ * rounded and saturated to [-1, 1) */
+
+void q15FromReal (const double * const frameT, q15 * const frameT_, const unsigned int n, const double scale);
+
+/* Convert 'n' single-precision complex values from 'frameF_' into 'frameF' */
+
+void complexFromFloat (const complexf * const frameF_, complex * const frameF, const unsigned int n);
+
+/* Convert 'n' Q15 complex values from 'frameF_' into 'frameF', multiplying them by 'gain' (for instance 'n*scale' to undo the scaling of rfftExecuteQ15();
+ * on samples converted by q15FromReal();, where 'n' is the length of the transform) */
+
+void complexFromQ15 (const complexq15 * const frameF_, complex * const frameF, const unsigned int n, const double gain);
+
+/* Return a batch for transforms of 'channels' frames of 'n' real samples each: 'n' must be even, otherwise NULL is returned (as it is if memory is
+ * exhausted). Call it outside the periodic activity */
+
+fftBatch* fftBatchCreate (const unsigned int n, const unsigned int channels);
+
+/* Evaluate the Fourier Transform of 'batch->channels' real frames: sample 'q' of frame 'c' is read from 'frameT[c*distance + q*stride]', so that both
+ * contiguous frames (stride 1, distance 'n') and interleaved multi-channel samples (stride 'channels', distance 1) are accepted. The 'n/2+1' non-redundant
+ * bins of frame 'c' are written from 'frameF[c*(n/2+1)]', with the same results of rfftExecute(); up to rounding errors. Frames whose half length is a power
+ * of 2 are transformed BATCH_LANES at a time, the others one by one */
+
+void fftBatchExecute (const fftBatch * const batch, const double * const frameT, const unsigned int stride, const unsigned int distance,
+	complex * const frameF);
+
+/* Release a batch obtained by fftBatchCreate(); */
+
+void fftBatchDestroy (fftBatch * const batch);
+
+/* Allocate a split-complex frame of 'n' values. NULL is returned if memory is exhausted */
+
+splitFrame* splitCreate (const unsigned int n);
+
+/* Free a split-complex frame obtained by splitCreate(); */
+
+void splitDestroy (splitFrame * const frame);
+
+/* Convert 'n' complex values from 'frameF' into the split-complex frame 'frameS' */
+
+void splitFromComplex (const complex * const frameF, splitFrame * const frameS, const unsigned int n);
+
+/* Convert 'n' values from the split-complex frame 'frameS' into 'frameF' */
+
+void complexFromSplit (const splitFrame * const frameS, complex * const frameF, const unsigned int n);
+
+/* Split-complex version of fftExecute();: 'frameS' must have room for 'plan->n' values */
+
+void fftExecuteSplit (const fftPlan * const plan, const double * const frameT, splitFrame * const frameS);
+
+/* Split-complex version of rfftExecute();: 'frameS' must have room for 'plan->n/2+1' values */
+
+void rfftExecuteSplit (const rfftPlan * const plan, const double * const frameT, splitFrame * const frameS);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,767 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* Batched datagram calls (sendmmsg();) are declared by the C library of Linux only with _GNU_SOURCE, before any include, and io_uring is driven there by
+ * its own system calls: elsewhere (VxWorks included) records are written by writev(); and datagrams are sent one at a time */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#define MMSG_CALLS
+#define URING_CALLS
+#endif
+
+/* H library */
+
+#include "dspAsync.h"
+
+/* Project private libraries */
+
+#include "dspFrame.h"
+
+/* Generic private libraries */
+
+#include "errno.h"
+#include "stdio.h" 									/*For sprintf(); and snprintf(); utilities*/
+#include "stdlib.h" 								/*For malloc();, calloc(); and free(); utilities*/
+#include "string.h" 								/*For memset(); utility*/
+
+/* VxWorks private libraries */
+
+#include "ioLib.h" 									/*I/O interface library*/
+#include "sockLib.h" 								/*Generic socket library*/
+#include "inetLib.h" 								/*Internet address manipulation routines*/
+#include "hostLib.h" 								/*Host table subroutine library*/
+#include "sysLib.h" 								/*For sysClkRateGet(); utility*/
+#include "sys/uio.h" 								/*For writev(); utility*/
+
+/* Linux private libraries */
+
+#ifdef URING_CALLS
+#include "linux/io_uring.h" 						/*io_uring interface*/
+#include "sys/mman.h" 								/*Memory mapping library*/
+#include "sys/syscall.h" 							/*For syscall(); utility*/
+#include "unistd.h"
+#endif
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Message of a batch of datagrams: struct mmsghdr where batched calls are available, a structure with the same layout elsewhere */
+
+#ifdef MMSG_CALLS
+typedef struct mmsghdr datagramMessage;
+#else
+typedef struct datagramMessage {
+
+	struct msghdr msg_hdr; 							/*Message of the datagram*/
+	unsigned int msg_len; 							/*Bytes transferred*/
+
+} datagramMessage;
+#endif
+
+/* io_uring instance: its submission and completion rings, shared with the kernel by a single mapping, and the array of submission entries */
+
+#ifdef URING_CALLS
+typedef struct uringInstance {
+
+	int fd; 										/*Handle of the instance*/
+	void *rings; 									/*Mapping of both rings*/
+	size_t ringsSize; 								/*Bytes of 'rings'*/
+	struct io_uring_sqe *entries; 					/*Submission entries (mapped)*/
+	size_t entriesSize; 							/*Bytes of 'entries'*/
+
+	unsigned int *sqTail; 							/*Submission ring: tail (advanced by the worker), mask and indexes of the entries*/
+	unsigned int *sqMask;
+	unsigned int *sqArray;
+	unsigned int *cqHead; 							/*Completion ring: head (advanced by the worker), tail, mask and completions*/
+	unsigned int *cqTail;
+	unsigned int *cqMask;
+	struct io_uring_cqe *completions;
+
+} uringInstance;
+#endif
+
+/* Workers spawned so far, numbering their names */
+
+unsigned int workers = 0;
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+#ifdef URING_CALLS
+
+/* Release an io_uring instance obtained by uringCreate(); */
+
+void uringDestroy (uringInstance * const ring) {
+
+	if (ring->entries != MAP_FAILED) munmap (ring->entries, ring->entriesSize);
+	if (ring->rings != MAP_FAILED) munmap (ring->rings, ring->ringsSize);
+	close (ring->fd);
+	free (ring);
+
+}
+
+/* Create an io_uring instance of 'depth' entries. NULL is returned if io_uring isn't available, or lacks writes at the current file position (before Linux 5.6) */
+
+uringInstance* uringCreate (const unsigned int depth) {
+
+	struct io_uring_params params;
+	uringInstance *ring;
+	size_t cqSize;
+
+	memset (&params, 0, sizeof (params));
+
+	ring = (uringInstance*)malloc (sizeof (uringInstance));
+	if (ring == NULL) return NULL;
+
+	ring->fd = (int)syscall (__NR_io_uring_setup, depth, &params);
+	if (ring->fd < 0) {
+		free (ring);
+		return NULL;
+	}
+	ring->rings = MAP_FAILED;
+	ring->entries = MAP_FAILED;
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+		uringDestroy (ring);
+		return NULL;
+	}
+
+	ring->ringsSize = params.sq_off.array + params.sq_entries*sizeof (unsigned int);
+	cqSize = params.cq_off.cqes + params.cq_entries*sizeof (struct io_uring_cqe);
+	if (cqSize > ring->ringsSize) ring->ringsSize = cqSize;
+	ring->entriesSize = params.sq_entries*sizeof (struct io_uring_sqe);
+
+	ring->rings = mmap (NULL, ring->ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	ring->entries = (struct io_uring_sqe*)mmap (NULL, ring->entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->rings == MAP_FAILED || ring->entries == MAP_FAILED) {
+		uringDestroy (ring);
+		return NULL;
+	}
+
+	ring->sqTail = (unsigned int*)((char*)ring->rings + params.sq_off.tail);
+	ring->sqMask = (unsigned int*)((char*)ring->rings + params.sq_off.ring_mask);
+	ring->sqArray = (unsigned int*)((char*)ring->rings + params.sq_off.array);
+	ring->cqHead = (unsigned int*)((char*)ring->rings + params.cq_off.head);
+	ring->cqTail = (unsigned int*)((char*)ring->rings + params.cq_off.tail);
+	ring->cqMask = (unsigned int*)((char*)ring->rings + params.cq_off.ring_mask);
+	ring->completions = (struct io_uring_cqe*)((char*)ring->rings + params.cq_off.cqes);
+
+	return ring;
+
+}
+
+/* Write 'batches' groups of records to 'output' by a single io_uring submission: group 'b' is made of 'counts[b]' vectors of 'vectors' (following the ones
+ * of the previous groups), and its result (bytes written, or a negative error) is put in 'results[b]'. Groups are linked, so that they are written in
+ * order. ERROR is returned if the submission fails */
+
+STATUS uringWrite (uringInstance * const ring, const int output, const struct iovec * const vectors, const unsigned int * const counts,
+	const unsigned int batches, int * const results) {
+
+	const unsigned int tail = *ring->sqTail;
+	struct io_uring_sqe *entry;
+	struct io_uring_cqe *completion;
+	unsigned int first = 0;
+	unsigned int pending = batches; 														/*Entries not submitted yet*/
+	unsigned int reaped = 0;
+	unsigned int head, index;
+	int len;
+
+	unsigned int b;
+	for (b = 0; b < batches; b++) {
+		index = (tail + b) & *ring->sqMask;
+		entry = &ring->entries[index];
+		memset (entry, 0, sizeof (*entry));
+		entry->opcode = IORING_OP_WRITEV;
+		entry->fd = output;
+		entry->addr = (unsigned long)(vectors + first);
+		entry->len = counts[b];
+		entry->off = (__u64)-1; 															/*At the current position of the file, as writev();*/
+		entry->flags = (b + 1 < batches) ? IOSQE_IO_LINK : 0;
+		entry->user_data = b;
+		ring->sqArray[index] = index;
+		results[b] = -ECANCELED;
+		first += counts[b];
+	}
+	__atomic_store_n (ring->sqTail, tail + batches, __ATOMIC_RELEASE); 						/*Entries are visible to the kernel before the new tail*/
+
+	while (reaped < batches) {
+		len = (int)syscall (__NR_io_uring_enter, ring->fd, pending, batches - reaped, IORING_ENTER_GETEVENTS, NULL, 0);
+		if (len < 0 && errno != EINTR) return ERROR;
+		if (len > 0) pending -= ((unsigned int)len < pending) ? (unsigned int)len : pending;
+		for (head = *ring->cqHead; head != __atomic_load_n (ring->cqTail, __ATOMIC_ACQUIRE); head++) {
+			completion = &ring->completions[head & *ring->cqMask];
+			if (completion->user_data < batches) results[completion->user_data] = completion->res;
+			reaped++;
+		}
+		__atomic_store_n (ring->cqHead, head, __ATOMIC_RELEASE);
+	}
+
+	return OK;
+
+}
+
+#endif
+
+/* Write the 'count' records described by 'vectors' to 'output' by writev();, until all of them are written or an error occurs: the number of records
+ * not written is returned, and 'calls' is increased by the number of system calls */
+
+unsigned int writeVectors (const int output, struct iovec *vectors, unsigned int count, unsigned int * const calls) {
+
+	int len;
+
+	while (count > 0) {
+		len = writev (output, vectors, (int)count);
+		(*calls)++;
+		if (len == ERROR) return count;
+		while (count > 0 && (size_t)len >= vectors->iov_len) { 								/*Skip the records written, then resume the partial one*/
+			len -= (int)vectors->iov_len;
+			vectors++;
+			count--;
+		}
+		if (count > 0) {
+			vectors->iov_base = (char*)vectors->iov_base + len;
+			vectors->iov_len -= (size_t)len;
+		}
+	}
+
+	return 0;
+
+}
+
+/* Write in 'record' (of 'size' characters) the line of 'value' in the format of sendToUDP();, and return its length */
+
+unsigned int formatSample (char * const record, const unsigned int size, const double value) {
+
+	int len;
+
+	if (value < FORMAT_LIMIT && value > -FORMAT_LIMIT) {
+		len = (int)formatFixed (record, value);
+		record[len++] = '\n';
+		return (unsigned int)len;
+	}
+
+	len = snprintf (record, size, "%+.4f\n", value); 										/*NaNs and huge values, as sprintf(); writes them*/
+
+	return (len < 0) ? 0 : ((unsigned int)len < size) ? (unsigned int)len : size - 1; 		/*Truncated to the record*/
+
+}
+
+/* Write 'count' records of 'sink' to its file, starting from record 'first' (counted since its creation) */
+
+void drainStream (asyncSink * const sink, const unsigned int first, const unsigned int count) {
+
+	unsigned int failed = 0;
+	char *record;
+#ifdef URING_CALLS
+	unsigned int counts[SINK_DEPTH] = {0};
+	int results[SINK_DEPTH];
+	size_t bytes;
+	unsigned int batches = 0;
+	unsigned int b, v;
+#endif
+
+	unsigned int i;
+	for (i = 0; i < count; i++) {
+		record = sink->records + (size_t)((first + i) & (sink->slots - 1))*sink->size;
+		sink->vectors[i].iov_base = record;
+		sink->vectors[i].iov_len = sink->lengths[(first + i) & (sink->slots - 1)];
+	}
+
+#ifdef URING_CALLS
+	if (sink->uring != NULL) {
+		for (i = 0; i < count; i += SINK_BATCH) counts[batches++] = (count - i < SINK_BATCH) ? count - i : SINK_BATCH;
+		sink->calls++;
+		if (uringWrite ((uringInstance*)sink->uring, sink->device, sink->vectors, counts, batches, results) == OK) {
+			for (b = 0, i = 0; b < batches; b++) {
+				for (bytes = 0, v = i; v < i + counts[b]; v++) bytes += sink->vectors[v].iov_len;
+				if (results[b] < 0 || (size_t)results[b] != bytes) failed += counts[b]; 	/*Short writes as well (a full disk)*/
+				i += counts[b];
+			}
+			sink->written += count - failed;
+			sink->failed += failed;
+			return;
+		}
+		uringDestroy ((uringInstance*)sink->uring); 										/*io_uring is unusable: writev(); from now on*/
+		sink->uring = NULL;
+		sink->failed += count; 																/*Part of them may have been written*/
+		return;
+	}
+#endif
+
+	for (i = 0; i < count; i += SINK_BATCH) {
+		failed += writeVectors (sink->device, sink->vectors + i, (count - i < SINK_BATCH) ? count - i : SINK_BATCH, &sink->calls);
+	}
+	sink->written += count - failed;
+	sink->failed += failed;
+
+}
+
+/* Send 'count' records of 'sink' as datagrams, starting from record 'first' (counted since its creation) */
+
+void drainDatagrams (asyncSink * const sink, const unsigned int first, const unsigned int count) {
+
+	datagramMessage *messages = (datagramMessage*)sink->messages;
+	unsigned int sent = 0;
+	int len;
+
+	unsigned int i;
+	for (i = 0; i < count; i++) {
+		sink->vectors[i].iov_base = sink->records + (size_t)((first + i) & (sink->slots - 1))*sink->size;
+		sink->vectors[i].iov_len = sink->lengths[(first + i) & (sink->slots - 1)];
+	}
+
+	while (sent < count) {
+#ifdef MMSG_CALLS
+		len = sendmmsg (sink->device, messages + sent, count - sent, 0);
+#else
+		len = (sendmsg (sink->device, &messages[sent].msg_hdr, 0) == ERROR) ? ERROR : 1;
+#endif
+		sink->calls++;
+		if (len == ERROR || len == 0) { 													/*The first datagram is lost, the others are retried*/
+			sink->failed++;
+			len = 1;
+		}
+		else sink->written += (unsigned int)len;
+		sent += (unsigned int)len;
+	}
+
+}
+
+/* Body of the worker of 'sink': drain the ring whenever a batch is waiting (or SINK_LATENCY ms have passed), until the sink is destroyed */
+
+void drainer (asyncSink * const sink) {
+
+	unsigned int tail, count, limit;
+	boolean quit;
+
+#ifdef URING_CALLS
+	if (sink->type == SINK_STREAM) sink->uring = uringCreate (SINK_DEPTH); 					/*Owned by the worker: its completions interrupt no other task*/
+#endif
+
+	while (true) {
+		semTake (sink->ready, sink->latency);
+		quit = sink->quit; 																	/*Records pushed before sinkDestroy(); are drained below*/
+		tail = (unsigned int)vxAtomicGet (&sink->tail);
+		while ((count = (unsigned int)vxAtomicGet (&sink->head) - tail) > 0) {
+			limit = (sink->uring != NULL) ? SINK_BATCH*SINK_DEPTH : SINK_BATCH;
+			if (count > limit) count = limit;
+			if (sink->type == SINK_STREAM) drainStream (sink, tail, count);
+			else drainDatagrams (sink, tail, count);
+			tail += count;
+			vxAtomicSet (&sink->tail, (atomicVal_t)tail); 									/*Slots are handed back only after their I/O*/
+			semGive (sink->freed);
+		}
+		if (quit) break;
+	}
+
+#ifdef URING_CALLS
+	if (sink->uring != NULL) uringDestroy ((uringInstance*)sink->uring);
+#endif
+
+	semGive (sink->done); 																	/*Acknowledge the end of the task*/
+
+}
+
+/* Stop the worker of 'sink' (if spawned) and release all its resources */
+
+void releaseSink (asyncSink * const sink) {
+
+	if (sink->task != TASK_ID_ERROR) {
+		sink->quit = true;
+		semGive (sink->ready);
+		semTake (sink->done, WAIT_FOREVER);
+	}
+
+	if (sink->ready != NULL) semDelete (sink->ready);
+	if (sink->freed != NULL) semDelete (sink->freed);
+	if (sink->done != NULL) semDelete (sink->done);
+	free (sink->records);
+	free (sink->lengths);
+	free (sink->vectors);
+	free (sink->messages);
+	free (sink);
+
+}
+
+/* Create an asynchronous sink of 'device', sending datagrams to 'address' (SINK_DATAGRAM) */
+
+asyncSink* createSink (const int device, const sinkDevice type, const struct sockaddr_in * const address, const unsigned int slots,
+	const unsigned int size, const sinkPolicy policy, const int priority) {
+
+	asyncSink *sink;
+	datagramMessage *messages;
+	char name[16];
+
+	unsigned int i;
+
+	if (slots == 0 || slots > 0x80000000 || size == 0) return NULL;
+
+	sink = (asyncSink*)calloc (1, sizeof (asyncSink)); 										/*Pointers start NULL: releaseSink(); can be called at any point*/
+	if (sink == NULL) return NULL;
+
+	sink->device = device;
+	sink->type = type;
+	sink->policy = policy;
+	if (address != NULL) sink->address = *address;
+	for (sink->slots = 1; sink->slots < slots; sink->slots <<= 1);
+	sink->size = size;
+	sink->batch = (sink->slots/2 < SINK_BATCH) ? sink->slots/2 : SINK_BATCH;
+	if (sink->batch == 0) sink->batch = 1;
+	vxAtomicSet (&sink->head, 0);
+	vxAtomicSet (&sink->tail, 0);
+	sink->latency = (SINK_LATENCY*sysClkRateGet() + 999)/1000;
+	sink->task = TASK_ID_ERROR;
+
+	sink->records = (char*)malloc ((size_t)sink->slots*size);
+	sink->lengths = (unsigned int*)malloc (sink->slots*sizeof (unsigned int));
+	sink->vectors = (struct iovec*)malloc (SINK_BATCH*SINK_DEPTH*sizeof (struct iovec));
+	sink->ready = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+	sink->freed = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+	sink->done = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+	if (sink->records == NULL || sink->lengths == NULL || sink->vectors == NULL || sink->ready == NULL || sink->freed == NULL || sink->done == NULL) {
+		releaseSink (sink);
+		return NULL;
+	}
+
+	if (type == SINK_DATAGRAM) { 															/*Each message points to its own vector*/
+		sink->messages = calloc (SINK_BATCH, sizeof (datagramMessage));
+		if (sink->messages == NULL) {
+			releaseSink (sink);
+			return NULL;
+		}
+		messages = (datagramMessage*)sink->messages;
+		for (i = 0; i < SINK_BATCH; i++) {
+			messages[i].msg_hdr.msg_name = (void*)&sink->address;
+			messages[i].msg_hdr.msg_namelen = sizeof (struct sockaddr_in);
+			messages[i].msg_hdr.msg_iov = &sink->vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	sprintf (name, "tSink%u", workers++);
+	sink->task = taskSpawn (name, priority, VX_FP_TASK, SINK_STACK, (FUNCPTR)drainer, (_Vx_usr_arg_t)sink, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	if (sink->task == TASK_ID_ERROR) {
+		releaseSink (sink);
+		return NULL;
+	}
+
+	return sink;
+
+}
+
+/* Body of the worker of 'source': parse frames taken from the pool into the free references of the ring, waiting while none is free (or for a tick while
+ * the pool is exhausted), until the end of file or the destruction of the source */
+
+void prefetcher (prefetchSource * const source) {
+
+	dspFrame *frame;
+	unsigned int head = 0;
+	STATUS st = OK;
+
+	while (!source->quit && st != EOF_REACHED) {
+		if (head - (unsigned int)vxAtomicGet (&source->tail) == source->buffers) { 			/*The ring is full*/
+			semTake (source->space, WAIT_FOREVER);
+			continue;
+		}
+		if ((frame = frameAlloc (source->pool)) == NULL) { 									/*Released by other stages, which don't signal it*/
+			semTake (source->space, 1);
+			continue;
+		}
+		frame->length = source->length;
+		frame->type = SAMPLE_REAL;
+		st = acquireFromReader (source->reader, frame->samples, source->length);
+		if (st == EOF_REACHED) {
+			frameRelease (frame);
+			frame = NULL;
+		}
+		source->ready[head & (source->buffers - 1)] = frame;
+		source->status[head & (source->buffers - 1)] = st;
+		vxAtomicSet (&source->head, (atomicVal_t)++head); 									/*The frame is parsed before the new head is seen*/
+	}
+
+	semGive (source->done); 																/*Acknowledge the end of the task*/
+
+}
+
+/* Stop the worker of 'source' (if spawned) and release all its resources */
+
+void releaseSource (prefetchSource * const source) {
+
+	unsigned int tail;
+
+	if (source->task != TASK_ID_ERROR) {
+		source->quit = true;
+		semGive (source->space);
+		semTake (source->done, WAIT_FOREVER); 												/*Immediate if the end of file has been reached*/
+		for (tail = (unsigned int)vxAtomicGet (&source->tail); tail != (unsigned int)vxAtomicGet (&source->head); tail++) {
+			if (source->ready[tail & (source->buffers - 1)] != NULL) frameRelease (source->ready[tail & (source->buffers - 1)]);
+		}
+	}
+
+	if (source->held != NULL) frameRelease (source->held);
+	if (source->owned && source->pool != NULL) poolDestroy (source->pool);
+	if (source->reader != NULL) readerDestroy (source->reader);
+	if (source->space != NULL) semDelete (source->space);
+	if (source->done != NULL) semDelete (source->done);
+	free (source->ready);
+	free (source->status);
+	free (source);
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create an asynchronous sink of file 'output', with 'slots' slots of 'size' bytes */
+
+asyncSink* sinkCreate (const int output, const unsigned int slots, const unsigned int size, const sinkPolicy policy, const int priority) {
+
+	return createSink (output, SINK_STREAM, NULL, slots, size, policy, priority);
+
+}
+
+/* Create an asynchronous sink of datagrams to 'ip' and 'port' through 'UDPSocket', with 'slots' slots of 'size' bytes */
+
+asyncSink* sinkCreateUDP (const int UDPSocket, char * const ip, const unsigned int port, const unsigned int slots, const unsigned int size,
+	const sinkPolicy policy, const int priority) {
+
+	struct sockaddr_in address;
+
+	memset (&address, 0, sizeof (address));
+	address.sin_len = (u_char)sizeof (struct sockaddr_in);
+	address.sin_family = AF_INET;
+	address.sin_port = htons (port);
+	if ((address.sin_addr.s_addr = inet_addr (ip)) == ERROR && (address.sin_addr.s_addr = hostGetByName (ip)) == ERROR) return NULL;
+
+	if (size > UDP_PAYLOAD) return NULL;
+
+	return createSink (UDPSocket, SINK_DATAGRAM, &address, slots, size, policy, priority);
+
+}
+
+/* Reserve the next slot of 'sink' */
+
+char* sinkReserve (asyncSink * const sink) {
+
+	const unsigned int head = (unsigned int)vxAtomicGet (&sink->head);
+
+	if (head - (unsigned int)vxAtomicGet (&sink->tail) == sink->slots) {
+		if (sink->policy == SINK_DROP) {
+			sink->dropped++;
+			return NULL;
+		}
+		sink->waited++;
+		while (head - (unsigned int)vxAtomicGet (&sink->tail) == sink->slots) {
+			semGive (sink->ready); 															/*A full ring is a full batch*/
+			semTake (sink->freed, WAIT_FOREVER);
+		}
+	}
+
+	return sink->records + (size_t)(head & (sink->slots - 1))*sink->size;
+
+}
+
+/* Push the record of 'length' bytes written in the slot returned by the last sinkReserve(); */
+
+STATUS sinkCommit (asyncSink * const sink, const unsigned int length) {
+
+	const unsigned int head = (unsigned int)vxAtomicGet (&sink->head);
+	unsigned int waiting;
+
+	sink->lengths[head & (sink->slots - 1)] = (length < sink->size) ? length : sink->size;
+	vxAtomicSet (&sink->head, (atomicVal_t)(head + 1)); 									/*The record is written before the new head is seen*/
+	sink->pushed++;
+
+	waiting = head + 1 - (unsigned int)vxAtomicGet (&sink->tail);
+	if (waiting > sink->peak) sink->peak = waiting;
+	if (waiting >= sink->batch) semGive (sink->ready);
+	if (4*(unsigned long long)waiting > 3*(unsigned long long)sink->slots) {
+		sink->congested++;
+		return SINK_CONGESTED;
+	}
+
+	return OK;
+
+}
+
+/* Push 'n' complex data taken from 'frameF' to 'sink', as a single record */
+
+STATUS sendToSink (asyncSink * const sink, const complex * const frameF, const unsigned int n) {
+
+	char *record;
+	unsigned int length = 0;
+
+	unsigned int index;
+
+	if ((unsigned long long)n*MAX_LINE_LENGTH > sink->size) return ERROR;
+	if ((record = sinkReserve (sink)) == NULL) return RECORD_DROPPED;
+
+	for (index = 0; index < n; index++) length += formatLine (record + length, &frameF[index]);
+
+	return sinkCommit (sink, length);
+
+}
+
+/* Push 'n' real data taken from 'frameR' to 'sink', as a single record */
+
+STATUS sendRealToSink (asyncSink * const sink, const double * const frameR, const unsigned int n) {
+
+	char *record;
+	unsigned int length = 0;
+
+	unsigned int index;
+
+	if ((unsigned long long)n*MAX_LINE_LENGTH > sink->size) return ERROR;
+	if ((record = sinkReserve (sink)) == NULL) return RECORD_DROPPED;
+
+	for (index = 0; index < n; index++) length += formatRealLine (record + length, frameR[index]);
+
+	return sinkCommit (sink, length);
+
+}
+
+/* Push 'n' double data taken from 'frameT' to 'sink', a record for each value */
+
+STATUS sendSamplesToSink (asyncSink * const sink, const double * const frameT, const unsigned int n) {
+
+	char *record;
+	STATUS st = OK;
+
+	unsigned int index;
+
+	if (sink->size < MAX_LINE_LENGTH) return ERROR;
+
+	for (index = 0; index < n; index++) {
+		if ((record = sinkReserve (sink)) == NULL) st = RECORD_DROPPED;
+		else if (sinkCommit (sink, formatSample (record, sink->size, frameT[index])) == SINK_CONGESTED && st == OK) st = SINK_CONGESTED;
+	}
+
+	return st;
+
+}
+
+/* Wait until all the records pushed to 'sink' so far have been written */
+
+void sinkFlush (asyncSink * const sink) {
+
+	const unsigned int head = (unsigned int)vxAtomicGet (&sink->head);
+
+	while ((unsigned int)vxAtomicGet (&sink->tail) != head) {
+		semGive (sink->ready);
+		semTake (sink->freed, WAIT_FOREVER);
+	}
+
+}
+
+/* Write all the records still waiting, stop the worker and release a sink obtained by sinkCreate(); or sinkCreateUDP(); */
+
+void sinkDestroy (asyncSink * const sink) {
+
+	releaseSink (sink);
+
+}
+
+/* Create a source prefetching frames of 'length' samples from the text file 'input' into a ring of 'buffers' frames */
+
+prefetchSource* prefetchCreate (const int input, const unsigned int length, const unsigned int buffers, const int priority) {
+
+	return prefetchCreate_ (input, length, buffers, priority, NULL);
+
+}
+
+/* General form of prefetchCreate();, taking frames from 'pool' */
+
+prefetchSource* prefetchCreate_ (const int input, const unsigned int length, const unsigned int buffers, const int priority, framePool * const pool) {
+
+	prefetchSource *source;
+	char name[16];
+
+	if (length == 0 || buffers > 0x80000000 || (pool != NULL && pool->capacity < length)) return NULL;
+
+	source = (prefetchSource*)calloc (1, sizeof (prefetchSource)); 							/*Pointers start NULL: releaseSource(); can be called at any point*/
+	if (source == NULL) return NULL;
+
+	source->length = length;
+	for (source->buffers = 2; source->buffers < buffers; source->buffers <<= 1);
+	vxAtomicSet (&source->head, 0);
+	vxAtomicSet (&source->tail, 0);
+	source->task = TASK_ID_ERROR;
+
+	source->owned = (pool == NULL);
+	source->pool = (pool != NULL) ? pool : poolCreate (source->buffers, length);
+	source->reader = readerCreate (input, READER_BLOCK);
+	source->ready = (dspFrame**)malloc (source->buffers*sizeof (dspFrame*));
+	source->status = (STATUS*)malloc (source->buffers*sizeof (STATUS));
+	source->space = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+	source->done = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+	if (source->pool == NULL || source->reader == NULL || source->ready == NULL || source->status == NULL || source->space == NULL || source->done == NULL) {
+		releaseSource (source);
+		return NULL;
+	}
+
+	sprintf (name, "tPrefetch%u", workers++);
+	source->task = taskSpawn (name, priority, VX_FP_TASK, SINK_STACK, (FUNCPTR)prefetcher, (_Vx_usr_arg_t)source, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	if (source->task == TASK_ID_ERROR) {
+		releaseSource (source);
+		return NULL;
+	}
+
+	return source;
+
+}
+
+/* Release the previous frame of 'source' and write in 'frameT' the samples of the next one */
+
+STATUS prefetchAcquire (prefetchSource * const source, double ** const frameT) {
+
+	STATUS st;
+
+	if (source->held != NULL) { 															/*Back to the pool, where the worker can take it again*/
+		frameRelease (source->held);
+		source->held = NULL;
+	}
+
+	st = prefetchTake (source, &source->held);
+	if (source->held != NULL) *frameT = source->held->samples;
+
+	return st;
+
+}
+
+/* Hand over in 'frame' the next frame of 'source', with its reference */
+
+STATUS prefetchTake (prefetchSource * const source, dspFrame ** const frame) {
+
+	const unsigned int tail = (unsigned int)vxAtomicGet (&source->tail);
+	STATUS st;
+
+	*frame = NULL;
+	if ((unsigned int)vxAtomicGet (&source->head) == tail) {
+		source->starved++;
+		return FRAME_NOT_READY;
+	}
+
+	st = source->status[tail & (source->buffers - 1)];
+	if (st == EOF_REACHED) return EOF_REACHED; 												/*Never taken: the end of file stays at the front*/
+
+	*frame = source->ready[tail & (source->buffers - 1)]; 									/*The reference of the source passes to the caller*/
+	vxAtomicSet (&source->tail, (atomicVal_t)(tail + 1));
+	semGive (source->space);
+	source->acquired++;
+
+	return st;
+
+}
+
+/* Stop the worker and release a source obtained by prefetchCreate(); */
+
+void prefetchDestroy (prefetchSource * const source) {
+
+	releaseSource (source);
+
+}
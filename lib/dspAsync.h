@@ -0,0 +1,218 @@
+/*
+ * This library provides asynchronous sinks and sources, so that periodic tasks never block on file or socket I/O: frames are formatted into the slots of a
+ * preallocated ring without locks, and a low-priority worker task drains it, many records for each system call (io_uring on Linux, when available). The
+ * other way round, a worker task parses the frames of an input file ahead of time into frames of a small pool, which are handed over by reference
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPASYNC_H
+#define DSPASYNC_H
+
+/* Parent library */
+
+#include "dspIO.h"
+
+/* VxWorks common libraries */
+
+#include "semLib.h"
+#include "taskLib.h"
+#include "vxAtomicLib.h" 							/*Atomic operations with memory barriers*/
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Messages (STATUS) */
+
+#define SINK_CONGESTED 								0x4c1b7e93
+#define RECORD_DROPPED 								0x2e96d05a
+
+/* Maximum number of records written by a system call, and of such calls submitted together to io_uring */
+
+#define SINK_BATCH 									64
+#define SINK_DEPTH 									8
+
+/* Maximum time (ms) a record waits in the ring when the worker hasn't been woken by a full batch */
+
+#define SINK_LATENCY 								100
+
+/* Stack size of sink workers */
+
+#define SINK_STACK 									8192
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* What a push does when all the slots of the ring are waiting for the worker */
+
+typedef enum sinkPolicy {
+	SINK_BLOCK = 0, 								/*The pushing task waits for a slot: no record is lost, but deadlines may be missed*/
+	SINK_DROP = 1 									/*The record is discarded and counted: the pushing task never waits*/
+} sinkPolicy;
+
+/* Devices of asynchronous sinks */
+
+typedef enum sinkDevice {
+	SINK_STREAM = 0, 								/*File: records are written one after the other*/
+	SINK_DATAGRAM = 1 								/*UDP socket: each record is a datagram*/
+} sinkDevice;
+
+/* Asynchronous sink. The ring has 'slots' slots of 'size' bytes: a single task pushes records into them, advancing 'head', while the worker drains them,
+ * advancing 'tail', so that neither needs a lock. The worker is woken once SINK_BATCH records (or half the ring) are waiting, and every SINK_LATENCY ms
+ * anyway. Counters are updated by the pusher (the first five) or by the worker (the others), and can be read at any time */
+
+typedef struct asyncSink {
+
+	int device; 									/*Handle of the file or socket (not owned by the sink)*/
+	sinkDevice type; 								/*Type of the device*/
+	sinkPolicy policy; 								/*Policy of pushes into a full ring*/
+	struct sockaddr_in address; 					/*Destination of the datagrams (SINK_DATAGRAM)*/
+
+	unsigned int slots; 							/*Number of slots (a power of 2)*/
+	unsigned int size; 								/*Bytes of a slot*/
+	unsigned int batch; 							/*Waiting records which wake the worker*/
+	char *records; 									/*Slots, one after the other*/
+	unsigned int *lengths; 							/*Bytes of the record in each slot*/
+	atomic_t head; 									/*Records pushed so far (written by the pushing task only)*/
+	atomic_t tail; 									/*Records drained so far (written by the worker only)*/
+
+	struct iovec *vectors; 							/*Records of the calls in progress*/
+	void *messages; 								/*Datagrams of the call in progress (SINK_DATAGRAM)*/
+	void *uring; 									/*io_uring instance of the worker (SINK_STREAM on Linux only, NULL if not available)*/
+
+	int latency; 									/*SINK_LATENCY in ticks*/
+	boolean quit; 									/*Set by sinkDestroy(); to stop the worker, once the ring is empty*/
+	TASK_ID task; 									/*Worker*/
+	SEM_ID ready; 									/*Given when a batch is waiting*/
+	SEM_ID freed; 									/*Given by the worker after freeing slots*/
+	SEM_ID done; 									/*Given by the worker at its end*/
+
+	unsigned int pushed; 							/*Records accepted*/
+	unsigned int dropped; 							/*Records discarded by SINK_DROP*/
+	unsigned int congested; 						/*Pushes which have found the ring more than 3/4 full*/
+	unsigned int waited; 							/*Pushes which have waited for a slot (SINK_BLOCK)*/
+	unsigned int peak; 								/*Maximum number of waiting records*/
+	unsigned int written; 							/*Records written by the worker*/
+	unsigned int failed; 							/*Records lost by I/O errors*/
+	unsigned int calls; 							/*System calls of the worker*/
+
+} asyncSink;
+
+/* Frames and pools of frames (see dspFrame.h) */
+
+struct dspFrame;
+struct framePool;
+
+/* Prefetching source: the worker parses the frames of 'length' samples of a text file, through a buffered reader, into frames taken from a pool (see
+ * dspFrame.h), and queues them in a ring of 'buffers' references ahead of the acquiring task, which takes them by advancing 'tail': a frame is handed
+ * over with its reference, never copied. As in asyncSink, each index is written by a single task, so that neither needs a lock */
+
+typedef struct prefetchSource {
+
+	fileReader *reader; 							/*Buffered reader of the file (the file isn't owned by the source)*/
+	unsigned int length; 							/*Samples of a frame*/
+	unsigned int buffers; 							/*References of the ring (a power of 2)*/
+	struct framePool *pool; 						/*Pool frames are taken from*/
+	boolean owned; 									/*Whether 'pool' has been created by the source*/
+	struct dspFrame **ready; 						/*Ring of the parsed frames, each with a reference held by the source (NULL at the end of file)*/
+	STATUS *status; 								/*Result of the acquisition of each frame (OK, MALFORMED_SAMPLE or EOF_REACHED)*/
+	atomic_t head; 									/*Frames parsed so far (written by the worker only)*/
+	atomic_t tail; 									/*Frames taken so far (written by the acquiring task only)*/
+	struct dspFrame *held; 							/*Frame returned by the last prefetchAcquire(); (NULL if none)*/
+
+	boolean quit; 									/*Set by prefetchDestroy(); to stop the worker*/
+	TASK_ID task; 									/*Worker*/
+	SEM_ID space; 									/*Given by the acquiring task after taking a frame*/
+	SEM_ID done; 									/*Given by the worker at its end*/
+
+	unsigned int acquired; 							/*Frames acquired*/
+	unsigned int starved; 							/*Acquisitions which have found no frame ready*/
+
+} prefetchSource;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Asynchronous sinks ------------------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create an asynchronous sink of file 'output', with 'slots' slots (rounded up to a power of 2) of 'size' bytes: a record must fit a slot (a spectrum of
+ * 'n' bins takes at most n*MAX_LINE_LENGTH bytes). Its worker is spawned with 'priority', which should be lower than the one of every periodic task.
+ * NULL is returned if 'slots' or 'size' is 0 or resources are exhausted. Call it outside the periodic activity */
+
+asyncSink* sinkCreate (const int output, const unsigned int slots, const unsigned int size, const sinkPolicy policy, const int priority);
+
+/* Create an asynchronous sink of datagrams to 'ip' and 'port' through 'UDPSocket', as sinkCreate(); (a record must fit a datagram as well). NULL is also
+ * returned if 'ip' is unknown */
+
+asyncSink* sinkCreateUDP (const int UDPSocket, char * const ip, const unsigned int port, const unsigned int slots, const unsigned int size,
+	const sinkPolicy policy, const int priority);
+
+/* Reserve the next slot of 'sink', where a record of up to 'sink->size' bytes can be written and then pushed by sinkCommit();. With SINK_BLOCK the calling
+ * task waits while the ring is full; with SINK_DROP NULL is returned instead, and the record is counted as dropped. Only one task may push into a sink */
+
+char* sinkReserve (asyncSink * const sink);
+
+/* Push the record of 'length' bytes written in the slot returned by the last sinkReserve();. SINK_CONGESTED is returned (the record is pushed anyway)
+ * when more than 3/4 of the ring is waiting, so that the pushing task can shed load before records are dropped or it waits */
+
+STATUS sinkCommit (asyncSink * const sink, const unsigned int length);
+
+/* Push 'n' complex data taken from 'frameF' to 'sink', as a single record with the text of sendToWriter();. ERROR is returned if the text may not fit a
+ * slot, RECORD_DROPPED if the record has been dropped, SINK_CONGESTED as sinkCommit(); */
+
+STATUS sendToSink (asyncSink * const sink, const complex * const frameF, const unsigned int n);
+
+/* Push 'n' real data taken from 'frameR' to 'sink', as a single record with the text of sendRealToWriter();. Return values as sendToSink(); */
+
+STATUS sendRealToSink (asyncSink * const sink, const double * const frameR, const unsigned int n);
+
+/* Push 'n' double data taken from 'frameT' to 'sink', a record (a datagram) for each value, with the text of sendToUDP(); (values too long for a record
+ * are truncated). RECORD_DROPPED is returned if any record has been dropped, SINK_CONGESTED as sinkCommit(); */
+
+STATUS sendSamplesToSink (asyncSink * const sink, const double * const frameT, const unsigned int n);
+
+/* Wake the worker of 'sink' and wait until all the records pushed so far have been written (or lost by I/O errors), so that its counters are final. Only
+ * the pushing task may call it */
+
+void sinkFlush (asyncSink * const sink);
+
+/* Write all the records still waiting, stop the worker and release a sink obtained by sinkCreate(); or sinkCreateUDP();. The device is still closed by the
+ * caller */
+
+void sinkDestroy (asyncSink * const sink);
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------ Prefetching sources ------------------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a source prefetching frames of 'length' samples from the text file 'input' into a ring of 'buffers' frames (rounded up to a power of 2, at least
+ * 2), parsed by a worker spawned with 'priority' (lower than the one of the acquiring task, but high enough to keep up with it). Frames are taken from a
+ * pool of 'buffers' frames of the source, so that up to 'buffers-1' are parsed ahead of the one held by prefetchAcquire();. NULL is returned if 'length'
+ * is 0 or resources are exhausted. Call it outside the periodic activity */
+
+prefetchSource* prefetchCreate (const int input, const unsigned int length, const unsigned int buffers, const int priority);
+
+/* General form of prefetchCreate();: frames are taken from 'pool' (NULL for a pool of the source), whose frames must hold 'length' samples, otherwise NULL
+ * is returned. While 'pool' has no free frame the worker polls it every tick (counting an exhausted allocation each time), so it should have 'buffers'
+ * frames more than its other users hold */
+
+prefetchSource* prefetchCreate_ (const int input, const unsigned int length, const unsigned int buffers, const int priority, struct framePool * const pool);
+
+/* Release the frame returned by the previous call and write in 'frameT' the samples of the next one parsed by the worker, which stay valid until the next
+ * call: no I/O, parsing or copy is done, and the calling task never waits. The same contract of acquireFromFile(); holds, plus FRAME_NOT_READY, returned
+ * (and counted) if the worker hasn't parsed the next frame yet ('frameT' isn't changed). After EOF_REACHED, the following calls return EOF_REACHED as
+ * well */
+
+STATUS prefetchAcquire (prefetchSource * const source, double ** const frameT);
+
+/* Hand over in 'frame' the next frame parsed by the worker, with its reference (released by the caller through frameRelease();), with the statuses of
+ * prefetchAcquire();. 'frame' is set to NULL unless OK or MALFORMED_SAMPLE is returned */
+
+STATUS prefetchTake (prefetchSource * const source, struct dspFrame ** const frame);
+
+/* Stop the worker and release a source obtained by prefetchCreate();. The file is still closed by the caller */
+
+void prefetchDestroy (prefetchSource * const source);
+
+#endif
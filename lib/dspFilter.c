@@ -0,0 +1,398 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* H library */
+
+#include "dspFilter.h"
+
+/* Project private libraries */
+
+#include "dspKernel.h"
+
+/* Generic private libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+#include "string.h" 								/*For memcpy(); and memmove(); utilities*/
+
+/* VxWorks private libraries */
+
+#include "memLib.h" 								/*For memalign(); utility*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Pi */
+
+#define PI 											3.14159265358979323846
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Write in 'h' the 'm' taps of a linear-phase low-pass FIR filter, with cutoff frequency 'cutoff' and unity gain at DC */
+
+void firLowpass (double * const h, const unsigned int m, const double cutoff) {
+
+	const double center = (m - 1)/2.0;
+
+	double x, sum = 0;
+
+	unsigned int j;
+	for (j = 0; j < m; j++) {
+		x = j - center;
+		h[j] = (x == 0) ? 2*cutoff : sin(2*PI*cutoff*x)/(PI*x); 							/*Ideal low-pass response...*/
+		if (m > 1) h[j] *= 0.42 - 0.5*cos((2*PI*j)/(m - 1)) + 0.08*cos((4*PI*j)/(m - 1)); 	/*...weighted by a symmetric Blackman window*/
+		sum += h[j];
+	}
+
+	for (j = 0; j < m; j++) h[j] /= sum;
+
+}
+
+/* Write in 'coefficients' the 'sections' biquad sections of a Butterworth low-pass IIR filter of order 2*sections, with cutoff frequency 'cutoff' */
+
+void biquadLowpass (double * const coefficients, const unsigned int sections, const double cutoff) {
+
+	const double w = 2*PI*cutoff;
+
+	double q, alpha, a0;
+	double *c;
+
+	unsigned int s;
+	for (s = 0; s < sections; s++) {
+		q = 1/(2*cos((PI*(2*s + 1))/(4*sections))); 										/*Quality factor of each pair of Butterworth poles*/
+		alpha = sin(w)/(2*q);
+		a0 = 1 + alpha;
+		c = coefficients + 5*s;
+		c[0] = (1 - cos(w))/(2*a0);
+		c[1] = (1 - cos(w))/a0;
+		c[2] = c[0];
+		c[3] = -2*cos(w)/a0;
+		c[4] = (1 - alpha)/a0;
+	}
+
+}
+
+/* Create a FIR filter with the 'm' taps contained in 'h' */
+
+firFilter* firCreate (const double * const h, const unsigned int m) {
+
+	firFilter *filter;
+
+	unsigned int j;
+
+	if (m == 0) return NULL;
+
+	filter = (firFilter*)malloc (sizeof (firFilter));
+	if (filter == NULL) return NULL;
+
+	filter->m = m;
+	filter->taps = (double*)memalign (SPLIT_ALIGNMENT, m*sizeof (double));
+	filter->buffer = (double*)memalign (SPLIT_ALIGNMENT, (m - 1 + FILTER_BLOCK)*sizeof (double));
+
+	if (filter->taps == NULL || filter->buffer == NULL) {
+		free (filter->taps);
+		free (filter->buffer);
+		free (filter);
+		return NULL;
+	}
+
+	for (j = 0; j < m; j++) filter->taps[j] = h[m - 1 - j];
+	for (j = 0; j < m - 1; j++) filter->buffer[j] = 0;
+
+	return filter;
+
+}
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' */
+
+void firExecute (firFilter * const filter, const double * const frameT, double * const frameT_, const unsigned int n) {
+
+	const unsigned int history = filter->m - 1;
+	const firKernel kernel = kernelSelect()->fir;
+
+	unsigned int block;
+
+	unsigned int done, i;
+	for (done = 0; done < n; done += block) {
+		block = (n - done < FILTER_BLOCK) ? n - done : FILTER_BLOCK;
+		memcpy (filter->buffer + history, frameT + done, block*sizeof (double)); 			/*Inputs are copied before outputs overwrite them*/
+		for (i = 0; i < block; i++) frameT_[done + i] = 0;
+		kernel (filter->buffer, filter->taps, filter->m, frameT_ + done, block);
+		memmove (filter->buffer, filter->buffer + block, history*sizeof (double)); 			/*The last 'm-1' samples open the next block*/
+	}
+
+}
+
+/* Release a FIR filter obtained by firCreate(); */
+
+void firDestroy (firFilter * const filter) {
+
+	free (filter->taps);
+	free (filter->buffer);
+	free (filter);
+
+}
+
+/* Create a cascade of 'sections' biquad IIR sections, whose coefficients are contained in 'coefficients' */
+
+biquadCascade* biquadCreate (const double * const coefficients, const unsigned int sections) {
+
+	biquadCascade *filter;
+
+	unsigned int j;
+
+	if (sections == 0) return NULL;
+
+	filter = (biquadCascade*)malloc (sizeof (biquadCascade));
+	if (filter == NULL) return NULL;
+
+	filter->sections = sections;
+	filter->coefficient = (double*)malloc (5*sections*sizeof (double));
+	filter->state = (double*)calloc (2*sections, sizeof (double));
+
+	if (filter->coefficient == NULL || filter->state == NULL) {
+		free (filter->coefficient);
+		free (filter->state);
+		free (filter);
+		return NULL;
+	}
+
+	for (j = 0; j < 5*sections; j++) filter->coefficient[j] = coefficients[j];
+
+	return filter;
+
+}
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' */
+
+void biquadExecute (biquadCascade * const filter, const double * const frameT, double * const frameT_, const unsigned int n) {
+
+	const double *c;
+	double x, y, z1, z2;
+
+	unsigned int s, i;
+
+	if (frameT_ != frameT) memcpy (frameT_, frameT, n*sizeof (double));
+
+	for (s = 0; s < filter->sections; s++) {
+		c = filter->coefficient + 5*s;
+		z1 = filter->state[2*s];
+		z2 = filter->state[2*s + 1];
+		for (i = 0; i < n; i++) {
+			x = frameT_[i];
+			y = c[0]*x + z1;
+			z1 = c[1]*x - c[3]*y + z2;
+			z2 = c[2]*x - c[4]*y;
+			frameT_[i] = y;
+		}
+		filter->state[2*s] = z1;
+		filter->state[2*s + 1] = z2;
+	}
+
+}
+
+/* Release a cascade of biquad sections obtained by biquadCreate(); */
+
+void biquadDestroy (biquadCascade * const filter) {
+
+	free (filter->coefficient);
+	free (filter->state);
+	free (filter);
+
+}
+
+/* Create a polyphase decimator by 'factor', with the 'm' anti-aliasing taps contained in 'h' */
+
+decimator* decimatorCreate (const double * const h, const unsigned int m, const unsigned int factor) {
+
+	decimator *filter;
+	unsigned int span, j;
+
+	unsigned int p, q;
+
+	if (m == 0 || factor == 0) return NULL;
+
+	filter = (decimator*)malloc (sizeof (decimator));
+	if (filter == NULL) return NULL;
+
+	filter->m = m;
+	filter->factor = factor;
+	filter->length = (m + factor - 1)/factor;
+	span = filter->length*factor; 															/*Taps after zero-padding*/
+	filter->taps = (double*)memalign (SPLIT_ALIGNMENT, span*sizeof (double));
+	filter->buffer = (double*)memalign (SPLIT_ALIGNMENT, (span - 1 + factor*FILTER_BLOCK)*sizeof (double));
+	filter->filled = span - 1;
+	filter->phase = (double*)memalign (SPLIT_ALIGNMENT, factor*(FILTER_BLOCK + filter->length - 1)*sizeof (double));
+
+	if (filter->taps == NULL || filter->buffer == NULL || filter->phase == NULL) {
+		free (filter->taps);
+		free (filter->buffer);
+		free (filter->phase);
+		free (filter);
+		return NULL;
+	}
+
+	for (p = 0; p < factor; p++) { 															/*Reversed tap 'p+factor*q' is tap 'q' of phase 'p'*/
+		for (q = 0; q < filter->length; q++) {
+			j = span - 1 - (p + factor*q);
+			filter->taps[p*filter->length + q] = (j < m) ? h[j] : 0;
+		}
+	}
+	for (j = 0; j < span - 1; j++) filter->buffer[j] = 0;
+
+	return filter;
+
+}
+
+/* Filter and decimate 'n' samples contained in 'frameT', writing outputs in 'frameT_' and returning their number */
+
+unsigned int decimatorExecute (decimator * const filter, const double * const frameT, double * const frameT_, const unsigned int n) {
+
+	const unsigned int factor = filter->factor;
+	const unsigned int length = filter->length;
+	const unsigned int span = length*factor;
+	const unsigned int capacity = span - 1 + factor*FILTER_BLOCK;
+	const unsigned int stride = FILTER_BLOCK + length - 1; 									/*Distance between the samples of consecutive phases*/
+	const firKernel kernel = kernelSelect()->fir;
+
+	unsigned int block, count, outputs = 0;
+
+	unsigned int done, i, p, t;
+	for (done = 0; done < n; done += block) {
+		block = (n - done < capacity - filter->filled) ? n - done : capacity - filter->filled;
+		memcpy (filter->buffer + filter->filled, frameT + done, block*sizeof (double));
+		filter->filled += block;
+		if (filter->filled < span) continue;
+		count = (filter->filled - span)/factor + 1; 										/*Windows of 'span' samples, 'factor' samples apart*/
+		for (p = 0; p < factor; p++) { 														/*Split the samples into phases...*/
+			for (t = 0; t < count + length - 1; t++) filter->phase[p*stride + t] = filter->buffer[p + factor*t];
+		}
+		for (i = 0; i < count; i++) frameT_[outputs + i] = 0;
+		for (p = 0; p < factor; p++) { 														/*...and accumulate the contribution of each one*/
+			kernel (filter->phase + p*stride, filter->taps + p*length, length, frameT_ + outputs, count);
+		}
+		outputs += count;
+		filter->filled -= factor*count;
+		memmove (filter->buffer, filter->buffer + factor*count, filter->filled*sizeof (double));
+	}
+
+	return outputs;
+
+}
+
+/* Release a polyphase decimator obtained by decimatorCreate(); */
+
+void decimatorDestroy (decimator * const filter) {
+
+	free (filter->taps);
+	free (filter->buffer);
+	free (filter->phase);
+	free (filter);
+
+}
+
+/* Create a FFT-based convolution with the 'm' taps contained in 'h', filtering blocks of 'block' samples by 'method' */
+
+convolver* convolverCreate (const double * const h, const unsigned int m, const unsigned int block, const convolutionMethod method) {
+
+	convolver *filter;
+	unsigned int n;
+
+	unsigned int q;
+
+	if (m == 0 || block == 0) return NULL;
+
+	for (n = 2; n < block + m - 1; n *= 2); 												/*Linear convolution of a block: no circular wrap-around*/
+
+	filter = (convolver*)malloc (sizeof (convolver));
+	if (filter == NULL) return NULL;
+
+	filter->m = m;
+	filter->block = block;
+	filter->n = n;
+	filter->method = method;
+	filter->plan = rfftCreate (n);
+	filter->response = (complex*)malloc ((n/2 + 1)*sizeof (complex));
+	filter->spectrum = (complex*)malloc ((n/2 + 1)*sizeof (complex));
+	filter->frame = (double*)memalign (SPLIT_ALIGNMENT, n*sizeof (double));
+	filter->state = (double*)calloc (n, sizeof (double)); 									/*Enough for both methods*/
+
+	if (filter->plan == NULL || filter->response == NULL || filter->spectrum == NULL || filter->frame == NULL || filter->state == NULL) {
+		if (filter->plan != NULL) rfftDestroy (filter->plan);
+		free (filter->response);
+		free (filter->spectrum);
+		free (filter->frame);
+		free (filter->state);
+		free (filter);
+		return NULL;
+	}
+
+	for (q = 0; q < n; q++) filter->frame[q] = (q < m) ? h[q] : 0;
+	rfftExecute (filter->plan, filter->frame, filter->response);
+
+	return filter;
+
+}
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' */
+
+STATUS convolverExecute (convolver * const filter, const double * const frameT, double * const frameT_, const unsigned int n) {
+
+	const unsigned int block = filter->block;
+	const unsigned int tail = filter->m - 1; 												/*Overlap-add: samples carried to the next block*/
+	const unsigned int history = filter->n - block; 										/*Overlap-save: samples preceding each block*/
+	const multiplyKernel multiply = kernelSelect()->multiply;
+
+	double * const frame = filter->frame;
+	double * const state = filter->state;
+
+	unsigned int done, q;
+
+	if (n % block != 0) return NOT_MULTIPLE_OF_BLOCK;
+
+	for (done = 0; done < n; done += block) {
+		if (filter->method == CONVOLUTION_OVERLAP_ADD) {
+			for (q = 0; q < block; q++) frame[q] = frameT[done + q];
+			for (q = block; q < filter->n; q++) frame[q] = 0;
+			rfftExecute (filter->plan, frame, filter->spectrum);
+		}
+		else {
+			for (q = 0; q < history; q++) frame[q] = state[q];
+			for (q = 0; q < block; q++) frame[history + q] = frameT[done + q];
+			rfftExecute (filter->plan, frame, filter->spectrum);
+			for (q = 0; q < history; q++) state[q] = frame[block + q]; 						/*The last 'history' samples precede the next block*/
+		}
+		multiply (filter->spectrum, filter->response, filter->n/2 + 1);
+		irfftExecute (filter->plan, filter->spectrum, frame);
+		if (filter->method == CONVOLUTION_OVERLAP_ADD) {
+			for (q = 0; q < block; q++) frameT_[done + q] = frame[q] + ((q < tail) ? state[q] : 0);
+			for (q = 0; q < tail; q++) { 													/*Tails longer than a block overlap more blocks*/
+				state[q] = frame[block + q] + ((block + q < tail) ? state[block + q] : 0);
+			}
+		}
+		else {
+			for (q = 0; q < block; q++) frameT_[done + q] = frame[history + q]; 			/*The first 'history' outputs are wrapped around*/
+		}
+	}
+
+	return OK;
+
+}
+
+/* Release a FFT-based convolution obtained by convolverCreate(); */
+
+void convolverDestroy (convolver * const filter) {
+
+	rfftDestroy (filter->plan);
+	free (filter->response);
+	free (filter->spectrum);
+	free (filter->frame);
+	free (filter->state);
+	free (filter);
+
+}
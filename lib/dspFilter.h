@@ -0,0 +1,166 @@
+/*
+ * This library provides filtering stages for time samples: FIR filters, cascades of biquad IIR sections and polyphase decimators. Every stage keeps its state
+ * across calls, so that consecutive frames (of any length) are filtered as a single stream, with no transient at their boundaries
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPFILTER_H
+#define DSPFILTER_H
+
+/* Parent library */
+
+#include "dsp.h"
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Maximum number of output samples evaluated by a FIR kernel call: longer frames are filtered in blocks, so that the working set stays in cache */
+
+#define FILTER_BLOCK 								256
+
+/* Messages (STATUS) */
+
+#define NOT_MULTIPLE_OF_BLOCK 						0x5be3f019
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* FIR filter with 'm' taps: y(t) = h[0]*x(t) + h[1]*x(t-1) + ... + h[m-1]*x(t-m+1). Taps are stored reversed, and the last 'm-1' input samples are kept
+ * in front of the block being filtered, so that each output is a contiguous dot product (see firKernel in dspKernel.h) */
+
+typedef struct firFilter {
+
+	unsigned int m; 								/*Number of taps*/
+	double *taps; 									/*Taps in reverse order*/
+	double *buffer; 								/*Last 'm-1' input samples, followed by the block being filtered*/
+
+} firFilter;
+
+/* Cascade of 'sections' biquad IIR sections, each one H(z) = (b0 + b1*z^-1 + b2*z^-2)/(1 + a1*z^-1 + a2*z^-2), in transposed direct form II. Every section
+ * runs over the whole frame before the next one, so that its coefficients and state stay in registers */
+
+typedef struct biquadCascade {
+
+	unsigned int sections; 							/*Number of sections*/
+	double *coefficient; 							/*b0, b1, b2, a1 and a2 of each section*/
+	double *state; 									/*Two state variables for each section*/
+
+} biquadCascade;
+
+/* Polyphase decimator by 'factor': the input is filtered by 'm' taps and one output out of 'factor' is kept. Taps are split into 'factor' phases of
+ * 'length' taps, each one applied to the input samples of the same phase, so that outputs which would be discarded are never evaluated */
+
+typedef struct decimator {
+
+	unsigned int m; 								/*Number of taps*/
+	unsigned int factor; 							/*Decimation factor*/
+	unsigned int length; 							/*Taps of a phase: ceil(m/factor)*/
+
+	double *taps; 									/*Reversed taps (zero-padded to 'length*factor'), phase after phase*/
+	double *buffer; 								/*Input samples not consumed yet: the first one opens the window of the next output*/
+	unsigned int filled; 							/*Samples in 'buffer'*/
+	double *phase; 									/*Input samples of each phase, 'FILTER_BLOCK+length-1' for each one*/
+
+} decimator;
+
+/* Block convolution methods */
+
+typedef enum convolutionMethod {
+	CONVOLUTION_OVERLAP_ADD = 0, 					/*Zero-padded blocks are transformed, and the tails of their outputs are added to the next ones*/
+	CONVOLUTION_OVERLAP_SAVE = 1 					/*Blocks are transformed with the preceding samples, and the outputs corrupted by circular wrap-around are discarded*/
+} convolutionMethod;
+
+/* FFT-based convolution with 'm' taps, evaluated on blocks of 'block' samples through transforms of length 'n' (the least power of 2 not lower than
+ * 'block+m-1'): each block costs two real transforms and 'n/2+1' complex products, so that with 'block' close to 'm' a sample costs O(log(m)) operations
+ * instead of the O(m) of firFilter */
+
+typedef struct convolver {
+
+	unsigned int m; 								/*Number of taps*/
+	unsigned int block; 							/*Samples filtered by each transform*/
+	unsigned int n; 								/*Length of the transforms*/
+	convolutionMethod method; 						/*Block convolution method*/
+
+	rfftPlan *plan; 								/*Plan of the real transforms of length 'n'*/
+	complex *response; 								/*Non-redundant bins of the taps, zero-padded to 'n'*/
+	complex *spectrum; 								/*Non-redundant bins of the block being filtered*/
+	double *frame; 									/*Block being filtered, in the time domain*/
+	double *state; 									/*Overlap-add: tail of the previous outputs ('m-1' samples). Overlap-save: last 'n-block' input samples*/
+
+} convolver;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------- Filtering ----------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Write in 'h' the 'm' taps of a linear-phase low-pass FIR filter, with cutoff frequency 'cutoff' (relative to the sample rate, 0<cutoff<0.5) and unity
+ * gain at DC: a sinc weighted by a Blackman window, whose transition band is about 5.5/m wide and whose stopband is attenuated by about 74 dB */
+
+void firLowpass (double * const h, const unsigned int m, const double cutoff);
+
+/* Write in 'coefficients' the 'sections' biquad sections (5 coefficients each, see biquadCascade) of a Butterworth low-pass IIR filter of order
+ * 2*sections, with cutoff frequency 'cutoff' (relative to the sample rate, 0<cutoff<0.5), designed by the bilinear transform */
+
+void biquadLowpass (double * const coefficients, const unsigned int sections, const double cutoff);
+
+/* Create a FIR filter with the 'm' taps contained in 'h'. Its history starts with zeros. NULL is returned if 'm' is 0 or memory is exhausted. Call it
+ * outside the periodic activity */
+
+firFilter* firCreate (const double * const h, const unsigned int m);
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' ('frameT_' may be 'frameT'). The last 'm-1' samples are kept for the next
+ * call */
+
+void firExecute (firFilter * const filter, const double * const frameT, double * const frameT_, const unsigned int n);
+
+/* Release a FIR filter obtained by firCreate(); */
+
+void firDestroy (firFilter * const filter);
+
+/* Create a cascade of 'sections' biquad IIR sections, whose coefficients (b0, b1, b2, a1 and a2 of each section) are contained in 'coefficients'. Its state
+ * starts with zeros. NULL is returned if 'sections' is 0 or memory is exhausted. Call it outside the periodic activity */
+
+biquadCascade* biquadCreate (const double * const coefficients, const unsigned int sections);
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' ('frameT_' may be 'frameT') */
+
+void biquadExecute (biquadCascade * const filter, const double * const frameT, double * const frameT_, const unsigned int n);
+
+/* Release a cascade of biquad sections obtained by biquadCreate(); */
+
+void biquadDestroy (biquadCascade * const filter);
+
+/* Create a polyphase decimator by 'factor', with the 'm' anti-aliasing taps contained in 'h' (for instance given by firLowpass(); with a cutoff below
+ * 0.5/factor). Its history starts with zeros. NULL is returned if 'm' or 'factor' is 0 or memory is exhausted. Call it outside the periodic activity */
+
+decimator* decimatorCreate (const double * const h, const unsigned int m, const unsigned int factor);
+
+/* Filter and decimate 'n' samples contained in 'frameT', writing outputs in 'frameT_' ('frameT_' may be 'frameT') and returning their number. Outputs are
+ * the samples of the filtered stream whose index is a multiple of 'factor': when 'n' is a multiple of 'factor' each call returns 'n/factor' outputs,
+ * otherwise the remaining samples are kept for the next call */
+
+unsigned int decimatorExecute (decimator * const filter, const double * const frameT, double * const frameT_, const unsigned int n);
+
+/* Release a polyphase decimator obtained by decimatorCreate(); */
+
+void decimatorDestroy (decimator * const filter);
+
+/* Create a FFT-based convolution with the 'm' taps contained in 'h', filtering blocks of 'block' samples by 'method'. Both methods give the same outputs of
+ * firExecute();, up to rounding errors, and keep their state across calls. NULL is returned if 'm' or 'block' is 0 or memory is exhausted. Call it outside
+ * the periodic activity */
+
+convolver* convolverCreate (const double * const h, const unsigned int m, const unsigned int block, const convolutionMethod method);
+
+/* Filter 'n' samples contained in 'frameT', writing 'n' outputs in 'frameT_' ('frameT_' may be 'frameT'). 'n' must be a multiple of 'filter->block',
+ * otherwise NOT_MULTIPLE_OF_BLOCK is returned and nothing is done */
+
+STATUS convolverExecute (convolver * const filter, const double * const frameT, double * const frameT_, const unsigned int n);
+
+/* Release a FFT-based convolution obtained by convolverCreate(); */
+
+void convolverDestroy (convolver * const filter);
+
+#endif
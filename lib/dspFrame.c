@@ -0,0 +1,413 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* H library */
+
+#include "dspFrame.h"
+
+/* Generic private libraries */
+
+#include "stdlib.h" 								/*For malloc();, calloc(); and free(); utilities*/
+
+/* VxWorks private libraries */
+
+#include "memLib.h" 								/*For memalign(); utility*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Acquisition routines of the devices of dspIO.h and dspAsync.h */
+
+STATUS fromFile (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromFile (source->handle, frame->samples, frame->length);
+
+}
+
+STATUS fromReader (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromReader ((fileReader*)source->device, frame->samples, frame->length);
+
+}
+
+STATUS fromMapping (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromMapping ((fileMapping*)source->device, frame->samples, frame->length);
+
+}
+
+STATUS fromUDP (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromUDP ((udpReceiver*)source->device, frame->samples, frame->length);
+
+}
+
+STATUS fromBinaryFile (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromBinaryFile (source->handle, frame->samples, frameValues (frame));
+
+}
+
+STATUS fromDecoder (const frameSource * const source, dspFrame * const frame) {
+
+	return acquireFromDecoder ((spectrumCodec*)source->device, frame->samples);
+
+}
+
+/* Handover routine of prefetching sources, which parse frames of their own (taken from the same pool) */
+
+STATUS fromPrefetch (const frameSource * const source, dspFrame ** const frame) {
+
+	return prefetchTake ((prefetchSource*)source->device, frame);
+
+}
+
+/* Sending routines of the devices of dspIO.h and dspAsync.h */
+
+STATUS toFile (const frameSink * const sink, const dspFrame * const frame) {
+
+	if (frame->type == SAMPLE_COMPLEX) sendToFile (sink->handle, (const complex*)frame->samples, frame->length);
+	else sendRealToFile (sink->handle, frame->samples, frame->length);
+
+	return OK;
+
+}
+
+STATUS toWriter (const frameSink * const sink, const dspFrame * const frame) {
+
+	if (frame->type == SAMPLE_COMPLEX) return sendToWriter ((fileWriter*)sink->device, (const complex*)frame->samples, frame->length);
+	return sendRealToWriter ((fileWriter*)sink->device, frame->samples, frame->length);
+
+}
+
+STATUS toBinaryFile (const frameSink * const sink, const dspFrame * const frame) {
+
+	return sendBinaryToFile (sink->handle, frame->samples, frameValues (frame));
+
+}
+
+STATUS toUDP (const frameSink * const sink, const dspFrame * const frame) {
+
+	return sendToUDP (sink->handle, frame->samples, frameValues (frame));
+
+}
+
+STATUS toSender (const frameSink * const sink, const dspFrame * const frame) {
+
+	return sendFrameToUDP ((udpSender*)sink->device, frame->samples, frameValues (frame));
+
+}
+
+STATUS toAsync (const frameSink * const sink, const dspFrame * const frame) {
+
+	asyncSink * const async = (asyncSink*)sink->device;
+
+	if (async->type == SINK_DATAGRAM) return sendSamplesToSink (async, frame->samples, frameValues (frame));
+	if (frame->type == SAMPLE_COMPLEX) return sendToSink (async, (const complex*)frame->samples, frame->length);
+	return sendRealToSink (async, frame->samples, frame->length);
+
+}
+
+STATUS toEncoder (const frameSink * const sink, const dspFrame * const frame) {
+
+	spectrumCodec * const encoder = (spectrumCodec*)sink->device;
+
+	if (frame->type != encoder->type || frame->length != encoder->bins) return ERROR;
+
+	return sendToEncoder (encoder, frame->samples);
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a pool of 'count' frames of 'capacity' values each */
+
+framePool* poolCreate (const unsigned int count, const unsigned int capacity) {
+
+	const unsigned int line = SPLIT_ALIGNMENT/sizeof (double); 								/*Doubles of a cache line*/
+	framePool *pool;
+
+	unsigned int i;
+
+	if (count == 0 || capacity == 0) return NULL;
+
+	pool = (framePool*)malloc (sizeof (framePool));
+	if (pool == NULL) return NULL;
+
+	pool->count = count;
+	pool->capacity = (capacity + line - 1)/line*line; 										/*Whole cache lines: the storage is aligned, so every frame starts on one*/
+	vxAtomicSet (&pool->next, 0);
+	vxAtomicSet (&pool->exhausted, 0);
+
+	pool->frames = (dspFrame*)calloc (count, sizeof (dspFrame));
+	pool->storage = (double*)memalign (SPLIT_ALIGNMENT, (size_t)count*pool->capacity*sizeof (double));
+	if (pool->frames == NULL || pool->storage == NULL) {
+		free (pool->frames);
+		free (pool->storage);
+		free (pool);
+		return NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		pool->frames[i].samples = pool->storage + (size_t)i*pool->capacity;
+		pool->frames[i].type = SAMPLE_REAL;
+		pool->frames[i].pool = pool;
+		vxAtomicSet (&pool->frames[i].references, 0);
+	}
+
+	return pool;
+
+}
+
+/* Take a free frame of 'pool' */
+
+dspFrame* frameAlloc (framePool * const pool) {
+
+	const unsigned int first = (unsigned int)vxAtomicGet (&pool->next);
+	dspFrame *frame;
+
+	unsigned int i;
+	for (i = 0; i < pool->count; i++) {
+		frame = pool->frames + (first + i) % pool->count;
+		if (vxCas (&frame->references, 0, 1)) { 											/*Free: now held by the caller only*/
+			vxAtomicSet (&pool->next, (atomicVal_t)((first + i + 1) % pool->count));
+			return frame;
+		}
+	}
+
+	vxAtomicInc (&pool->exhausted);
+
+	return NULL;
+
+}
+
+/* Add a reference to 'frame' */
+
+void frameRetain (dspFrame * const frame) {
+
+	vxAtomicInc (&frame->references);
+
+}
+
+/* Drop a reference to 'frame' */
+
+void frameRelease (dspFrame * const frame) {
+
+	vxAtomicDec (&frame->references); 														/*At 0 the frame can be taken again*/
+
+}
+
+/* Number of values of the samples held by 'frame' */
+
+unsigned int frameValues (const dspFrame * const frame) {
+
+	return (frame->type == SAMPLE_COMPLEX) ? 2*frame->length : frame->length;
+
+}
+
+/* Release a pool obtained by poolCreate(); */
+
+void poolDestroy (framePool * const pool) {
+
+	free (pool->storage);
+	free (pool->frames);
+	free (pool);
+
+}
+
+/* Create a source of frames of 'length' samples of 'type', filled by 'acquire' */
+
+frameSource* sourceCreate (STATUS (*acquire) (const frameSource * const source, dspFrame * const frame), void * const device, const int handle,
+	framePool * const pool, const unsigned int length, const sampleType type) {
+
+	frameSource *source;
+
+	if (((type == SAMPLE_COMPLEX) ? 2*length : length) > pool->capacity) return NULL;
+
+	source = (frameSource*)malloc (sizeof (frameSource));
+	if (source == NULL) return NULL;
+
+	source->acquire = acquire;
+	source->take = NULL;
+	source->device = device;
+	source->handle = handle;
+	source->pool = pool;
+	source->length = length;
+	source->type = type;
+
+	return source;
+
+}
+
+/* Sources of real frames of 'length' samples, from each device */
+
+frameSource* sourceFromFile (const int input, framePool * const pool, const unsigned int length) {
+
+	return sourceCreate (fromFile, NULL, input, pool, length, SAMPLE_REAL);
+
+}
+
+frameSource* sourceFromReader (fileReader * const reader, framePool * const pool, const unsigned int length) {
+
+	return sourceCreate (fromReader, reader, ERROR, pool, length, SAMPLE_REAL);
+
+}
+
+frameSource* sourceFromMapping (fileMapping * const mapping, framePool * const pool, const unsigned int length) {
+
+	return sourceCreate (fromMapping, mapping, ERROR, pool, length, SAMPLE_REAL);
+
+}
+
+frameSource* sourceFromUDP (udpReceiver * const receiver, framePool * const pool, const unsigned int length) {
+
+	return sourceCreate (fromUDP, receiver, ERROR, pool, length, SAMPLE_REAL);
+
+}
+
+/* Source of the frames parsed by 'prefetch' into its pool */
+
+frameSource* sourceFromPrefetch (prefetchSource * const prefetch) {
+
+	frameSource * const source = sourceCreate (NULL, prefetch, ERROR, prefetch->pool, prefetch->length, SAMPLE_REAL);
+
+	if (source != NULL) source->take = fromPrefetch;
+
+	return source;
+
+}
+
+/* Source of the frames of the binary file 'input' */
+
+frameSource* sourceFromBinaryFile (const int input, const binaryHeader * const header, framePool * const pool) {
+
+	return sourceCreate (fromBinaryFile, NULL, input, pool, header->length*header->channels, header->type);
+
+}
+
+/* Source of the frames of a compressed file */
+
+frameSource* sourceFromDecoder (spectrumCodec * const decoder, framePool * const pool) {
+
+	return sourceCreate (fromDecoder, decoder, ERROR, pool, decoder->bins, decoder->type);
+
+}
+
+/* Take a frame of the pool of 'source' and fill it from its device */
+
+STATUS sourceAcquire (const frameSource * const source, dspFrame ** const frame) {
+
+	dspFrame *acquired;
+	STATUS st;
+
+	if (source->take != NULL) return source->take (source, frame); 							/*Already in a frame of the pool: no copy*/
+
+	*frame = NULL;
+	acquired = frameAlloc (source->pool);
+	if (acquired == NULL) return POOL_EXHAUSTED; 											/*The device isn't touched: nothing is lost*/
+
+	acquired->length = source->length;
+	acquired->type = source->type;
+	st = source->acquire (source, acquired);
+	if (st != OK && st != MALFORMED_SAMPLE) {
+		frameRelease (acquired);
+		return st;
+	}
+
+	*frame = acquired;
+
+	return st;
+
+}
+
+/* Release a source obtained by sourceCreate(); or a sourceFrom... routine */
+
+void frameSourceDestroy (frameSource * const source) {
+
+	free (source);
+
+}
+
+/* Create a sink of frames written by 'send' */
+
+frameSink* frameSinkCreate (STATUS (*send) (const frameSink * const sink, const dspFrame * const frame), void * const device, const int handle) {
+
+	frameSink *sink;
+
+	sink = (frameSink*)malloc (sizeof (frameSink));
+	if (sink == NULL) return NULL;
+
+	sink->send = send;
+	sink->device = device;
+	sink->handle = handle;
+
+	return sink;
+
+}
+
+/* Sinks of frames, to each device */
+
+frameSink* sinkToFile (const int output) {
+
+	return frameSinkCreate (toFile, NULL, output);
+
+}
+
+frameSink* sinkToWriter (fileWriter * const writer) {
+
+	return frameSinkCreate (toWriter, writer, ERROR);
+
+}
+
+frameSink* sinkToBinaryFile (const int output) {
+
+	return frameSinkCreate (toBinaryFile, NULL, output);
+
+}
+
+frameSink* sinkToUDP (const int UDPSocket) {
+
+	return frameSinkCreate (toUDP, NULL, UDPSocket);
+
+}
+
+frameSink* sinkToSender (udpSender * const sender) {
+
+	return frameSinkCreate (toSender, sender, ERROR);
+
+}
+
+frameSink* sinkToAsync (asyncSink * const sink) {
+
+	return frameSinkCreate (toAsync, sink, ERROR);
+
+}
+
+/* Sink compressing frames by 'encoder' */
+
+frameSink* sinkToEncoder (spectrumCodec * const encoder) {
+
+	return frameSinkCreate (toEncoder, encoder, ERROR);
+
+}
+
+/* Write 'frame' to the device of 'sink' */
+
+STATUS sinkSend (const frameSink * const sink, const dspFrame * const frame) {
+
+	return sink->send (sink, frame);
+
+}
+
+/* Release a sink obtained by frameSinkCreate(); or a sinkTo... routine */
+
+void frameSinkDestroy (frameSink * const sink) {
+
+	free (sink);
+
+}
@@ -0,0 +1,185 @@
+/*
+ * This library provides a common interface to the sources and sinks of dspIO.h and dspAsync.h, through which frames are handed from stage to stage by
+ * reference. Frames come from a preallocated pool, aligned to cache lines, and are reference-counted: each stage holding one releases it when done, and
+ * the last release gives it back to the pool. A new device only needs a routine filling a frame (or sending one) to be used by any stage
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPFRAME_H
+#define DSPFRAME_H
+
+/* Parent library */
+
+#include "dspAsync.h"
+
+/* VxWorks common libraries */
+
+#include "vxAtomicLib.h" 							/*Atomic operations with memory barriers*/
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Messages (STATUS) */
+
+#define POOL_EXHAUSTED 								0x5d31a8c6
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Frame of a pool. 'length' samples of 'type' are held in 'samples' (a complex sample takes two values). The frame is free while 'references' is 0 */
+
+typedef struct dspFrame {
+
+	double *samples; 								/*Values, starting on a cache line*/
+	unsigned int length; 							/*Samples held*/
+	sampleType type; 								/*Type of the samples*/
+	atomic_t references; 							/*Stages holding the frame*/
+	struct framePool *pool; 						/*Pool the frame belongs to*/
+
+} dspFrame;
+
+/* Pool of 'count' frames of 'capacity' values each. Frames are taken by a compare-and-swap of their reference count, starting from the one after the last
+ * taken, and given back by the last release: no lock is needed, so that any task can take or release frames at any time */
+
+typedef struct framePool {
+
+	dspFrame *frames; 								/*Frames of the pool*/
+	double *storage; 								/*Values of all the frames, one after the other (aligned to SPLIT_ALIGNMENT bytes)*/
+	unsigned int count; 							/*Number of frames*/
+	unsigned int capacity; 							/*Values of a frame (whole cache lines of SPLIT_ALIGNMENT bytes)*/
+	atomic_t next; 									/*Frame where the next search starts*/
+	atomic_t exhausted; 							/*Allocations which have found no free frame*/
+
+} framePool;
+
+/* Source of frames: 'acquire' fills a frame of 'length' samples from 'device' (or from the file or socket 'handle'), with the same contract of
+ * acquireFromFile();. Devices filling frames of their own (taken from the same pool) hand them over by 'take' instead, with the contract of
+ * sourceAcquire(); */
+
+typedef struct frameSource {
+
+	STATUS (*acquire) (const struct frameSource * const source, dspFrame * const frame); 	/*Routine of the device*/
+	STATUS (*take) (const struct frameSource * const source, dspFrame ** const frame); 		/*Routine of devices handing over frames (NULL for the others)*/
+	void *device; 									/*Reader, mapping, receiver... (not owned by the source)*/
+	int handle; 									/*File or socket (not owned by the source)*/
+	unsigned int length; 							/*Samples of a frame*/
+	sampleType type; 								/*Type of the samples*/
+	framePool *pool; 								/*Pool frames are taken from*/
+
+} frameSource;
+
+/* Sink of frames: 'send' writes a frame to 'device' (or to the file or socket 'handle') */
+
+typedef struct frameSink {
+
+	STATUS (*send) (const struct frameSink * const sink, const dspFrame * const frame); 	/*Routine of the device*/
+	void *device; 									/*Writer, sender, asynchronous sink... (not owned by the sink)*/
+	int handle; 									/*File or socket (not owned by the sink)*/
+
+} frameSink;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Frame pools ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a pool of 'count' frames of 'capacity' values each (rounded up to whole cache lines, so that every frame starts on one). NULL is returned if
+ * 'count' or 'capacity' is 0 or memory is exhausted. Call it outside the periodic activity */
+
+framePool* poolCreate (const unsigned int count, const unsigned int capacity);
+
+/* Take a free frame of 'pool', with a single reference held by the caller, or NULL if none is free (the allocation is counted as exhausted). Its samples
+ * are left as they were */
+
+dspFrame* frameAlloc (framePool * const pool);
+
+/* Add a reference to 'frame', for a stage it's handed to */
+
+void frameRetain (dspFrame * const frame);
+
+/* Drop a reference to 'frame': the last one gives it back to its pool. The frame can't be used anymore by the caller */
+
+void frameRelease (dspFrame * const frame);
+
+/* Number of values of the samples held by 'frame' */
+
+unsigned int frameValues (const dspFrame * const frame);
+
+/* Release a pool obtained by poolCreate();, once none of its frames is held anymore */
+
+void poolDestroy (framePool * const pool);
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Sources of frames ------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a source of frames of 'length' samples of 'type', taken from 'pool' and filled by 'acquire' from 'device' or 'handle'. NULL is returned if a frame
+ * of 'pool' can't hold them or memory is exhausted. Call it (and the following ones) outside the periodic activity */
+
+frameSource* sourceCreate (STATUS (*acquire) (const frameSource * const source, dspFrame * const frame), void * const device, const int handle,
+	framePool * const pool, const unsigned int length, const sampleType type);
+
+/* Sources of real frames of 'length' samples, acquired as by acquireFromFile();, acquireFromReader();, acquireFromMapping(); and acquireFromUDP(); */
+
+frameSource* sourceFromFile (const int input, framePool * const pool, const unsigned int length);
+frameSource* sourceFromReader (fileReader * const reader, framePool * const pool, const unsigned int length);
+frameSource* sourceFromMapping (fileMapping * const mapping, framePool * const pool, const unsigned int length);
+frameSource* sourceFromUDP (udpReceiver * const receiver, framePool * const pool, const unsigned int length);
+
+/* Source of the frames parsed by 'prefetch' into its pool (see prefetchCreate_();): they are handed over by prefetchTake();, with no copy */
+
+frameSource* sourceFromPrefetch (prefetchSource * const prefetch);
+
+/* Source of the frames of the binary file 'input', whose 'header' has already been read by acquireHeaderFromFile(); (all its channels fill a frame) */
+
+frameSource* sourceFromBinaryFile (const int input, const binaryHeader * const header, framePool * const pool);
+
+/* Source of the frames of a compressed file, restored by 'decoder' */
+
+frameSource* sourceFromDecoder (spectrumCodec * const decoder, framePool * const pool);
+
+/* Take a frame of the pool of 'source' and fill it from its device (or take the one filled by the device): the frame is written in 'frame', with a
+ * reference held by the caller, when OK or MALFORMED_SAMPLE is returned. Otherwise 'frame' is set to NULL, and the status of the device (EOF_REACHED,
+ * FRAME_NOT_READY...) or POOL_EXHAUSTED is returned, with nothing acquired */
+
+STATUS sourceAcquire (const frameSource * const source, dspFrame ** const frame);
+
+/* Release a source obtained by one of the routines above. The device is still released by the caller */
+
+void frameSourceDestroy (frameSource * const source);
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Sinks of frames -------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a sink of frames written by 'send' to 'device' or 'handle'. NULL is returned if memory is exhausted. Call it (and the following ones) outside the
+ * periodic activity */
+
+frameSink* frameSinkCreate (STATUS (*send) (const frameSink * const sink, const dspFrame * const frame), void * const device, const int handle);
+
+/* Sinks writing frames as sendToFile(); or sendRealToFile();, sendToWriter(); or sendRealToWriter(); (depending on the type of the frame),
+ * sendBinaryToFile();, sendToUDP(); (after initUDP();), sendFrameToUDP(); and the records of an asynchronous sink (as sendToSink(); or sendRealToSink(); for
+ * files, sendSamplesToSink(); for datagrams). Complex frames are written to binary files and UDP sockets as pairs of values */
+
+frameSink* sinkToFile (const int output);
+frameSink* sinkToWriter (fileWriter * const writer);
+frameSink* sinkToBinaryFile (const int output);
+frameSink* sinkToUDP (const int UDPSocket);
+frameSink* sinkToSender (udpSender * const sender);
+frameSink* sinkToAsync (asyncSink * const sink);
+
+/* Sink compressing frames by 'encoder' (sendToEncoder();): ERROR is returned for frames of another type or length */
+
+frameSink* sinkToEncoder (spectrumCodec * const encoder);
+
+/* Write 'frame' to the device of 'sink', returning its status. The frame is only read: the caller still holds its reference */
+
+STATUS sinkSend (const frameSink * const sink, const dspFrame * const frame);
+
+/* Release a sink obtained by one of the routines above. The device is still released by the caller */
+
+void frameSinkDestroy (frameSink * const sink);
+
+#endif
@@ -1,158 +1,1401 @@
-/*
- * Author: Alessandro Trifoglio
- * Last revision: 22/12/2016
- */
-
-/* H library */
-
-#include "dspIO.h"
-
-/* Generic private libraries */
-
-#include "stdlib.h" 								/*For atof(); utility*/
-/*#include "string.h" 								For strlen(); utility*/
-
-/* VxWorks private libraries */
-
-#include "ioLib.h" 									/*I/O interface library*/
-#include "sockLib.h" 								/*Generic socket library*/
-#include "inetLib.h" 								/*Internet address manipulation routines*/
-#include "hostLib.h" 								/*Host table subroutine library*/
-
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Maximum number of characters for double values in input file: for instance, '-10.6887' has 8 characters */
-
-#define MAX_CHARACTERS 								10
-
-/* Maximum absolute value for doubles. Be consistent with the previous constraint, taking into account 4 digits of precision */
-
-#define MAX_ABSOLUTE_VALUE 							1000
-
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Server socket address */
-
-struct sockaddr_in serverAddr;
-
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Acquire 'n' data from file 'input' and put them into 'frameT' */
-
-STATUS acquireFromFile (const int input, double * const frameT, const unsigned int n) {
-
-	char buffer[MAX_CHARACTERS+2]; 															/*It may contain for instance '-10.6887\n\0'*/
-	
-	boolean EOFFound = false;
-	unsigned int index;
-
-	boolean newLineFound;
-	unsigned int i;
-	
-	for (index = 0; index < n; index++) {
-		
-		newLineFound = false;
-		for (i = 0; !EOFFound && !newLineFound && i < MAX_CHARACTERS+2; i++) {
-			if (read (input, buffer + i, 1) == 0) EOFFound = true;
-			else if (buffer[i] == '\n') { 													/*Single values are separated by a newline character*/
-				buffer[i] = '\0';
-				newLineFound = true;
-			}
-		}
-		
-		if (EOFFound) return EOF_REACHED; 													/*If end of file has been reached, return*/
-
-		frameT[index] = atof (buffer); 														/*Convert the content of 'buffer' into a double*/
-	
-	}
-	
-	return OK;
-
-}
-
-/* Send 'n' complex data taken from 'frameF' to file 'output' */
-
-void sendToFile (const int output, const complex * const frameF, const unsigned int n) {
-
-	char buffer[2*MAX_CHARACTERS+8]; 														/*It may contain for instance '-10.6887 + j(-10.6887)\n\0'*/
-	int len;
-	
-	unsigned int index;
-
-	for (index = 0; index < n; index++) {
-
-		if (frameF[index].real < MAX_ABSOLUTE_VALUE && frameF[index].imag < MAX_ABSOLUTE_VALUE) {
-			len = sprintf (buffer, "%+.4f + j(%+.4f)\n", frameF[index].real, frameF[index].imag);
-		}
-		else len = sprintf (buffer, "NaN\n"); 												/*IEEE arithmetic representation for Not a Number*/
-		
-		write (output, buffer, len);
-
-	}
-
-}
-
-/* Init UDP connection structure. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
-
-STATUS initUDP (const int UDPSocket, char * const ip, const unsigned int port) {
-
-	int sockAddrSize = sizeof (struct sockaddr_in); 										/*Size of socket address structure*/
-
-	/*bzero ((char*)&serverAddr, sockAddrSize);*/
-	serverAddr.sin_len = (u_char)sockAddrSize;
-	serverAddr.sin_family = AF_INET;
-	serverAddr.sin_port = htons (port);
-
-	if ((serverAddr.sin_addr.s_addr = inet_addr (ip)) == ERROR &&
-		(serverAddr.sin_addr.s_addr = hostGetByName (ip)) == ERROR) {
-		close (UDPSocket);
-		return ERROR;
-	}
-
-	return OK;
-
-}
-
-/* Send 'n' double data taken from 'frameT' to 'UDPSocket'. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
-
-STATUS sendToUDP (const int UDPSocket, const double * const frameT, const unsigned int n) {
-
-	char buffer[MAX_CHARACTERS+2]; 															/*It may contain for instance '-10.6887\n\0'*/
-	int len;
-
-	unsigned int index;
-
-	for (index = 0; index < n; index++) {
-
-		len = sprintf (buffer, "%+.4f\n", frameT[index]);
-
-		if ((len = sendto (UDPSocket, buffer, len, 0, (struct sockaddr*)&serverAddr, (int)serverAddr.sin_len)) == ERROR) {
-			close (UDPSocket);
-			return ERROR;
-		}
-
-	}
-
-	return OK;
-
-}
-
-/* Copy a frame 'frameIn' into another 'frameOut' with the same length 'n' */
-
-void frmcpy (const double * const frameIn, double * const frameOut, const unsigned int n) {
-	
-	unsigned int index;
-	
-	for (index = 0; index < n; index++) {
-		
-		frameOut[index] = frameIn[index];
-		
-	}
-	
-}
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 22/12/2016
+ */
+
+/* Batched datagram calls (sendmmsg(); and recvmmsg();) are declared by the C library of Linux only with _GNU_SOURCE, before any include: elsewhere
+ * (VxWorks included) datagrams are sent and received one at a time */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#define MMSG_CALLS
+#endif
+
+/* H library */
+
+#include "dspIO.h"
+
+/* Generic private libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+#include "string.h" 								/*For memchr();, memcpy();, memmove(); and strncmp(); utilities*/
+
+/* VxWorks private libraries */
+
+#include "ioLib.h" 									/*I/O interface library*/
+#include "sockLib.h" 								/*Generic socket library*/
+#include "inetLib.h" 								/*Internet address manipulation routines*/
+#include "hostLib.h" 								/*Host table subroutine library*/
+#include "sysLib.h" 								/*For sysClkRateGet(); utility*/
+#include "tickLib.h" 								/*Clock tick library (for tickGet();)*/
+#include "sys/mman.h" 								/*Memory mapping library*/
+#include "sys/stat.h" 								/*For fstat(); utility*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Maximum number of characters for double values in input file: for instance, '-10.6887' has 8 characters */
+
+#define MAX_CHARACTERS 								10
+
+/* Maximum absolute value for doubles. Be consistent with the previous constraint, taking into account 4 digits of precision */
+
+#define MAX_ABSOLUTE_VALUE 							1000
+
+/* Splitter of Dekker's exact product */
+
+#define SPLITTER 									134217729.0
+
+/* Limit of quantized values of compressed spectra (2^50), and flag of blocks packing differences from the previous frame */
+
+#define CODEC_LIMIT 								1125899906842624.0
+#define CODEC_DELTA 								0x80
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Server socket address */
+
+struct sockaddr_in serverAddr;
+
+/* Message of a batch of datagrams: struct mmsghdr where batched calls are available, a structure with the same layout elsewhere */
+
+#ifdef MMSG_CALLS
+typedef struct mmsghdr datagramMessage;
+#else
+typedef struct datagramMessage {
+
+	struct msghdr msg_hdr; 							/*Message of the datagram*/
+	unsigned int msg_len; 							/*Bytes transferred*/
+
+} datagramMessage;
+#endif
+
+/* Exact powers of 10 (doubles represent them without errors up to 10^22), dividing the integer mantissa of parsed samples */
+
+const double powersOf10[MAX_DIGITS + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Parse a number in fixed-point decimal text (or 'NaN') starting at 'text', and write it in 'value'. The first character after the number is returned, or
+ * NULL if no number starts at 'text' */
+
+const char* parseNumber (const char * const text, double * const value) {
+
+	const char *c = text;
+	unsigned long long mantissa = 0;
+	unsigned int digits = 0; 																/*Significant digits (leading zeros excluded)*/
+	unsigned int decimals = 0;
+	boolean found = false; 																	/*Set by the first digit, leading zeros included*/
+	boolean negative = false;
+	boolean point = false;
+
+	while (*c == ' ' || *c == '\t') c++; 													/*Leading blanks are skipped, as atof(); does*/
+
+	if (strncmp (c, "NaN", 3) == 0) {
+		*value = NAN;
+		return c + 3;
+	}
+
+	if (*c == '+' || *c == '-') negative = (*c++ == '-');
+	for (; ; c++) {
+		if (*c >= '0' && *c <= '9') {
+			if (mantissa > 0 || *c != '0') digits++;
+			if (digits > MAX_DIGITS) return NULL;
+			mantissa = 10*mantissa + (unsigned int)(*c - '0');
+			if (point) decimals++;
+			found = true;
+		}
+		else if (*c == '.' && !point) point = true;
+		else break;
+	}
+	if (!found || decimals > MAX_DIGITS) return NULL;
+
+	*value = (double)mantissa/powersOf10[decimals]; 										/*Exact mantissa up to 15 significant digits: a single rounding*/
+	if (negative) *value = -*value;
+
+	return c;
+
+}
+
+/* Return true if only blanks (and '\r') are left in the text starting at 'c', up to '\0' or '\n' */
+
+boolean endOfLine (const char *c) {
+
+	while (*c == ' ' || *c == '\t' || *c == '\r') c++;
+
+	return *c == '\0' || *c == '\n';
+
+}
+
+/* Return true if the processor is little-endian, as the payload of binary files */
+
+boolean littleEndian (void) {
+
+	const unsigned int one = 1;
+
+	return *(const unsigned char*)&one == 1;
+
+}
+
+/* Reverse the bytes of each one of the 'n' doubles contained in 'values' */
+
+void swapBytes (double * const values, const unsigned int n) {
+
+	unsigned char *bytes;
+	unsigned char byte;
+
+	unsigned int index, i;
+	for (index = 0; index < n; index++) {
+		bytes = (unsigned char*)(values + index);
+		for (i = 0; i < sizeof (double)/2; i++) {
+			byte = bytes[i];
+			bytes[i] = bytes[sizeof (double) - 1 - i];
+			bytes[sizeof (double) - 1 - i] = byte;
+		}
+	}
+
+}
+
+/* Write 'size' bytes taken from 'data' to file 'output', retrying partial writes */
+
+STATUS writeAll (const int output, const char * const data, const size_t size) {
+
+	size_t done = 0;
+	int len;
+
+	while (done < size) {
+		if ((len = write (output, (char*)data + done, size - done)) <= 0) return ERROR;
+		done += (size_t)len;
+	}
+
+	return OK;
+
+}
+
+/* Read 'size' bytes from file 'input' into 'data', retrying partial reads: EOF_REACHED is returned if the file ends (or fails) first */
+
+STATUS readAll (const int input, char * const data, const size_t size) {
+
+	size_t done = 0;
+	int len;
+
+	while (done < size) {
+		if ((len = read (input, data + done, size - done)) <= 0) return EOF_REACHED;
+		done += (size_t)len;
+	}
+
+	return OK;
+
+}
+
+/* Write the characters waiting in the block buffer of 'writer' to its file, and empty it */
+
+STATUS flushWriter (fileWriter * const writer) {
+
+	const unsigned int used = writer->used;
+
+	writer->used = 0; 																		/*Dropped on errors as well: the next frame starts clean*/
+
+	return writeAll (writer->output, writer->block, used);
+
+}
+
+/* Send the first 'count' datagrams of 'messages' through 'UDPSocket', returning how many of them have been sent (ERROR if none) */
+
+int sendBatch (const int UDPSocket, datagramMessage * const messages, const unsigned int count) {
+
+#ifdef MMSG_CALLS
+	return sendmmsg (UDPSocket, messages, count, 0); 										/*A single system call*/
+#else
+	unsigned int i;
+	for (i = 0; i < count; i++) {
+		if (sendmsg (UDPSocket, &messages[i].msg_hdr, 0) == ERROR) return (i > 0) ? (int)i : ERROR;
+	}
+
+	return (int)count;
+#endif
+
+}
+
+/* Receive up to 'count' datagrams through 'UDPSocket' into 'messages', without waiting: their number is returned (ERROR if none is waiting) */
+
+int receiveBatch (const int UDPSocket, datagramMessage * const messages, const unsigned int count) {
+
+#ifdef MMSG_CALLS
+	return recvmmsg (UDPSocket, messages, count, MSG_DONTWAIT, NULL); 						/*A single system call*/
+#else
+	int len;
+
+	if (count == 0 || (len = recvmsg (UDPSocket, &messages[0].msg_hdr, MSG_DONTWAIT)) == ERROR) return ERROR;
+	messages[0].msg_len = (unsigned int)len;
+
+	return 1;
+#endif
+
+}
+
+/* Place the datagram of 'size' bytes contained in 'datagram' into the window of 'receiver', and update its counters */
+
+void placeDatagram (udpReceiver * const receiver, const char * const datagram, const unsigned int size) {
+
+	datagramHeader header;
+	unsigned long long position;
+	boolean outside = false;
+
+	unsigned int i;
+
+	if (decodeDatagram (datagram, size, &header, receiver->samples) != OK) { 				/*Decoded into the receiver: stacks of periodic tasks are small*/
+		receiver->dropped++;
+		return;
+	}
+
+	receiver->received++;
+
+	position = (unsigned long long)header.frame*header.length + header.offset;
+	if (!receiver->started) { 																/*The stream starts with the frame of the first datagram*/
+		receiver->base = position - header.offset;
+		receiver->end = receiver->base;
+		receiver->next = header.sequence;
+		receiver->started = true;
+	}
+
+	if ((int)(header.sequence - receiver->next) >= 0) { 									/*Successors of the last one: the gap is lost so far*/
+		receiver->lost += header.sequence - receiver->next;
+		receiver->next = header.sequence + 1;
+	}
+	else { 																					/*A datagram counted as lost has arrived*/
+		receiver->reordered++;
+		if (receiver->lost > 0) receiver->lost--;
+	}
+
+	for (i = 0; i < header.count; i++, position++) { 										/*Samples already acquired, or with no room yet, are dropped*/
+		if (position < receiver->base || position >= receiver->base + receiver->capacity) {
+			outside = true;
+			continue;
+		}
+		receiver->window[position % receiver->capacity] = receiver->samples[i];
+		receiver->filled[position % receiver->capacity] = 1;
+		if (position >= receiver->end) receiver->end = position + 1;
+	}
+
+	if (outside) receiver->dropped++;
+
+}
+
+/* Write the 'bytes' least significant bytes of 'value' in 'field', least significant first */
+
+void storeLittle (unsigned char * const field, const unsigned int value, const unsigned int bytes) {
+
+	unsigned int i;
+	for (i = 0; i < bytes; i++) field[i] = (unsigned char)(value >> (8*i));
+
+}
+
+/* Return the value of the 'bytes' bytes of 'field', least significant first */
+
+unsigned int loadLittle (const unsigned char * const field, const unsigned int bytes) {
+
+	unsigned int value = 0;
+
+	unsigned int i;
+	for (i = 0; i < bytes; i++) value |= (unsigned int)field[i] << (8*i);
+
+	return value;
+
+}
+
+/* Return the multiple of the quantization step nearest to 'value' (already divided by the step), clipped to CODEC_LIMIT (0 for NaNs) */
+
+long long quantize (const double value) {
+
+	if (value < CODEC_LIMIT && value > -CODEC_LIMIT) return (long long)floor (value + 0.5);
+	if (value >= CODEC_LIMIT) return (long long)CODEC_LIMIT;
+	if (value <= -CODEC_LIMIT) return -(long long)CODEC_LIMIT;
+
+	return 0;
+
+}
+
+/* Map a signed value to an unsigned one, so that small magnitudes of both signs get few bits: 0, -1, 1, -2... become 0, 1, 2, 3... */
+
+unsigned long long zigzag (const long long value) {
+
+	return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+
+}
+
+/* Inverse of zigzag(); */
+
+long long unzigzag (const unsigned long long value) {
+
+	return (long long)(value >> 1) ^ -(long long)(value & 1);
+
+}
+
+/* Return the number of bits needed by 'value' (0 for 0) */
+
+unsigned int bitWidth (const unsigned long long value) {
+
+	unsigned int width = 0;
+
+	while (width < 64 && (value >> width) != 0) width++;
+
+	return width;
+
+}
+
+/* Allocate a codec of frames of 'bins' bins of 'type' on file 'device', with the quantization step 'precision'. NULL is returned if any argument isn't
+ * valid or memory is exhausted */
+
+spectrumCodec* codecCreate (const int device, const sampleType type, const unsigned int bins, const double precision) {
+
+	spectrumCodec *codec;
+	unsigned int blocks;
+
+	if (bins == 0 || bins > 0x10000000 || type > SAMPLE_COMPLEX || !(precision > 0 && precision < HUGE_VAL)) return NULL;
+
+	codec = (spectrumCodec*)calloc (1, sizeof (spectrumCodec));
+	if (codec == NULL) return NULL;
+
+	codec->device = device;
+	codec->type = type;
+	codec->bins = bins;
+	codec->values = (type == SAMPLE_COMPLEX) ? 2*bins : bins;
+	codec->precision = precision;
+	codec->scale = 1/precision;
+	blocks = (codec->values + CODEC_BLOCK - 1)/CODEC_BLOCK;
+	codec->size = 4 + blocks*(1 + (CODEC_BLOCK*CODEC_WIDTH + 7)/8); 						/*Every block at the maximum width*/
+
+	codec->previous = (long long*)calloc (codec->values, sizeof (long long)); 				/*The first frame is coded against zeros*/
+	codec->current = (long long*)calloc (codec->values, sizeof (long long));
+	codec->record = (unsigned char*)malloc (codec->size);
+	if (codec->previous == NULL || codec->current == NULL || codec->record == NULL) {
+		codecDestroy (codec);
+		return NULL;
+	}
+
+	return codec;
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Parse a sample written in fixed-point decimal text, ended by '\0' or '\n' */
+
+STATUS parseFixed (const char * const text, double * const value) {
+
+	double result;
+	const char *c = parseNumber (text, &result);
+
+	*value = 0;
+
+	if (c == NULL || !endOfLine (c)) return MALFORMED_SAMPLE; 								/*No number, or trailing characters*/
+
+	*value = result;
+
+	return OK;
+
+}
+
+/* Parse a complex sample written as 'a + j(b)' (the format of sendToFile();), ended by '\0' or '\n' */
+
+STATUS parseComplex (const char * const text, complex * const value) {
+
+	complex result;
+	const char *c = parseNumber (text, &result.real);
+
+	value->real = 0;
+	value->imag = 0;
+
+	if (c != NULL && isnan (result.real) && endOfLine (c)) { 								/*'NaN' stands for the whole value*/
+		value->real = NAN;
+		value->imag = NAN;
+		return OK;
+	}
+
+	if (c == NULL) return MALFORMED_SAMPLE;
+	while (*c == ' ') c++;
+	if (strncmp (c, "+ j(", 4) != 0) return MALFORMED_SAMPLE;
+	c = parseNumber (c + 4, &result.imag);
+	if (c == NULL || *c != ')' || !endOfLine (c + 1)) return MALFORMED_SAMPLE;
+
+	*value = result;
+
+	return OK;
+
+}
+
+/* Acquire 'n' data from file 'input' and put them into 'frameT' */
+
+STATUS acquireFromFile (const int input, double * const frameT, const unsigned int n) {
+
+	char buffer[MAX_CHARACTERS+2]; 															/*It may contain for instance '-10.6887\n\0'*/
+	
+	boolean EOFFound = false;
+	STATUS st = OK;
+	unsigned int index;
+
+	boolean newLineFound;
+	unsigned int i;
+	
+	for (index = 0; index < n; index++) {
+		
+		newLineFound = false;
+		for (i = 0; !EOFFound && !newLineFound && i < MAX_CHARACTERS+2; i++) {
+			if (read (input, buffer + i, 1) == 0) EOFFound = true;
+			else if (buffer[i] == '\n') { 													/*Single values are separated by a newline character*/
+				buffer[i] = '\0';
+				newLineFound = true;
+			}
+		}
+		
+		if (EOFFound) return EOF_REACHED; 													/*If end of file has been reached, return*/
+
+		if (parseFixed (buffer, frameT + index) != OK) st = MALFORMED_SAMPLE; 				/*Convert the content of 'buffer' into a double*/
+	
+	}
+	
+	return st;
+
+}
+
+/* Create a buffered reader of file 'input' with a block buffer of 'size' characters */
+
+fileReader* readerCreate (const int input, const unsigned int size) {
+
+	fileReader *reader;
+
+	if (size == 0) return NULL;
+
+	reader = (fileReader*)malloc (sizeof (fileReader));
+	if (reader == NULL) return NULL;
+
+	reader->block = (char*)malloc (size + 1); 												/*One more character terminates lines split by a full block*/
+	if (reader->block == NULL) {
+		free (reader);
+		return NULL;
+	}
+
+	reader->input = input;
+	reader->size = size;
+	reader->first = 0;
+	reader->last = 0;
+	reader->eof = false;
+
+	return reader;
+
+}
+
+/* Return the next line of 'reader' without its newline character, refilling the block buffer if needed */
+
+char* readerLine (fileReader * const reader) {
+
+	char *line;
+	char *newLine;
+	int count;
+
+	while (true) {
+
+		line = reader->block + reader->first;
+		newLine = (char*)memchr (line, '\n', reader->last - reader->first);
+		if (newLine != NULL) { 																/*Single values are separated by a newline character*/
+			*newLine = '\0';
+			reader->first = (unsigned int)(newLine + 1 - reader->block);
+			return line;
+		}
+
+		if (reader->eof) return NULL; 														/*An unterminated last line is discarded, as acquireFromFile(); does*/
+
+		if (reader->first == 0 && reader->last == reader->size) { 							/*No newline in a full block: split the line*/
+			reader->block[reader->size] = '\0';
+			reader->first = reader->last;
+			return line;
+		}
+
+		memmove (reader->block, line, reader->last - reader->first); 						/*Move the partial line to the front, then refill*/
+		reader->last -= reader->first;
+		reader->first = 0;
+
+		count = read (reader->input, reader->block + reader->last, reader->size - reader->last);
+		if (count <= 0) reader->eof = true; 												/*Errors end the input as well*/
+		else reader->last += (unsigned int)count;
+
+	}
+
+}
+
+/* Acquire 'n' data from 'reader' and put them into 'frameT' */
+
+STATUS acquireFromReader (fileReader * const reader, double * const frameT, const unsigned int n) {
+
+	char *line;
+	STATUS st = OK;
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+
+		if ((line = readerLine (reader)) == NULL) return EOF_REACHED; 						/*If end of file has been reached, return*/
+
+		if (parseFixed (line, frameT + index) != OK) st = MALFORMED_SAMPLE; 				/*Convert the content of 'line' into a double*/
+
+	}
+
+	return st;
+
+}
+
+/* Release a buffered reader obtained by readerCreate(); */
+
+void readerDestroy (fileReader * const reader) {
+
+	free (reader->block);
+	free (reader);
+
+}
+
+/* Map the whole file 'input' into memory, advising sequential access */
+
+fileMapping* mappingCreate (const int input) {
+
+	fileMapping *mapping;
+	struct stat status;
+	void *start;
+
+	if (fstat (input, &status) == ERROR) return NULL;
+
+	mapping = (fileMapping*)malloc (sizeof (fileMapping));
+	if (mapping == NULL) return NULL;
+
+	mapping->start = NULL; 																	/*Empty files can't be mapped: they end at once*/
+	mapping->size = (size_t)status.st_size;
+	mapping->cursor = 0;
+
+	if (mapping->size > 0) {
+		start = mmap (NULL, mapping->size, PROT_READ, MAP_PRIVATE, input, 0);
+		if (start == MAP_FAILED) {
+			free (mapping);
+			return NULL;
+		}
+		madvise (start, mapping->size, MADV_SEQUENTIAL); 									/*Only a hint: failures are harmless*/
+		mapping->start = (char*)start;
+	}
+
+	return mapping;
+
+}
+
+/* Acquire 'n' data from 'mapping' and put them into 'frameT' */
+
+STATUS acquireFromMapping (fileMapping * const mapping, double * const frameT, const unsigned int n) {
+
+	const char *line;
+	const char *newLine;
+	STATUS st = OK;
+
+	unsigned int index;
+
+	if (mapping->start == NULL && n > 0) return EOF_REACHED;
+
+	for (index = 0; index < n; index++) {
+
+		line = mapping->start + mapping->cursor; 											/*The mapping isn't terminated: lines are delimited first*/
+		newLine = (const char*)memchr (line, '\n', mapping->size - mapping->cursor);
+		if (newLine == NULL) return EOF_REACHED; 											/*An unterminated last line is discarded, as acquireFromFile(); does*/
+
+		if (parseFixed (line, frameT + index) != OK) st = MALFORMED_SAMPLE; 				/*The parser stops at the newline character*/
+		mapping->cursor = (size_t)(newLine + 1 - mapping->start);
+
+	}
+
+	return st;
+
+}
+
+/* Unmap and release a file mapping obtained by mappingCreate(); */
+
+void mappingDestroy (fileMapping * const mapping) {
+
+	if (mapping->start != NULL) munmap (mapping->start, mapping->size);
+	free (mapping);
+
+}
+
+/* Send 'n' complex data taken from 'frameF' to file 'output' */
+
+void sendToFile (const int output, const complex * const frameF, const unsigned int n) {
+
+	char buffer[2*MAX_CHARACTERS+8]; 														/*It may contain for instance '-10.6887 + j(-10.6887)\n\0'*/
+	int len;
+	
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+
+		if (frameF[index].real < MAX_ABSOLUTE_VALUE && frameF[index].imag < MAX_ABSOLUTE_VALUE) {
+			len = sprintf (buffer, "%+.4f + j(%+.4f)\n", frameF[index].real, frameF[index].imag);
+		}
+		else len = sprintf (buffer, "NaN\n"); 												/*IEEE arithmetic representation for Not a Number*/
+		
+		write (output, buffer, len);
+
+	}
+
+}
+
+/* Send 'n' complex data taken from the split-complex frame 'frameS' to file 'output', with the same format of sendToFile(); */
+
+void sendSplitToFile (const int output, const splitFrame * const frameS, const unsigned int n) {
+
+	complex value; 																			/*A value at a time: tasks may run on small stacks*/
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+		value.real = frameS->real[index];
+		value.imag = frameS->imag[index];
+		sendToFile (output, &value, 1);
+	}
+
+}
+
+/* Send 'n' real data taken from 'frameR' to file 'output', one value per line */
+
+void sendRealToFile (const int output, const double * const frameR, const unsigned int n) {
+
+	char buffer[MAX_LINE_LENGTH]; 															/*Reduced values (powers above all) may be large*/
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) write (output, buffer, formatRealLine (buffer, frameR[index]));
+
+}
+
+/* Write in 'buffer' the text of 'value' in the '%+.4f' format, without terminator, and return its length */
+
+unsigned int formatFixed (char * const buffer, const double value) {
+
+	const double magnitude = fabs (value);
+	const double split = SPLITTER*magnitude;
+	const double high = split - (split - magnitude); 										/*The upper 26 bits of 'magnitude'...*/
+	const double low = magnitude - high; 													/*...and the others*/
+	const double product = magnitude*10000;
+	const double error = (high*10000 - product) + low*10000; 								/*'product+error' is exactly 'magnitude*10^4'*/
+	const double integer = floor (product);
+	const double fraction = product - integer;
+
+	unsigned long long scaled;
+	unsigned long long whole;
+	unsigned int decimals;
+	char digits[12];
+	unsigned int len = 0;
+	unsigned int count = 0;
+
+	if (!(magnitude < FORMAT_LIMIT)) { 														/*NaNs included*/
+		memcpy (buffer, "NaN", 3);
+		return 3;
+	}
+
+	scaled = (unsigned long long)integer; 													/*Round the exact value, ties to even*/
+	if (fraction > 0.5 || (fraction == 0.5 && (error > 0 || (error == 0 && scaled % 2 == 1)))) scaled++;
+
+	whole = scaled/10000;
+	decimals = (unsigned int)(scaled % 10000);
+
+	buffer[len++] = signbit (value) ? '-' : '+'; 											/*'-0.0000' for negative values rounded to 0, as sprintf(); does*/
+
+	do { 																					/*Integer part (at least one digit), in reverse order*/
+		digits[count++] = (char)('0' + whole % 10);
+		whole /= 10;
+	} while (whole > 0);
+
+	while (count > 0) buffer[len++] = digits[--count];
+
+	buffer[len++] = '.';
+	buffer[len++] = (char)('0' + decimals/1000);
+	buffer[len++] = (char)('0' + (decimals/100) % 10);
+	buffer[len++] = (char)('0' + (decimals/10) % 10);
+	buffer[len++] = (char)('0' + decimals % 10);
+
+	return len;
+
+}
+
+/* Write the header of a binary file to file 'output' */
+
+STATUS sendHeaderToFile (const int output, const binaryHeader * const header) {
+
+	unsigned char field[BINARY_HEADER_SIZE];
+
+	storeLittle (field, BINARY_MAGIC, 4);
+	storeLittle (field + 4, BINARY_VERSION, 2);
+	storeLittle (field + 6, (unsigned int)header->type, 2);
+	storeLittle (field + 8, header->length, 4);
+	storeLittle (field + 12, header->rate, 4);
+	storeLittle (field + 16, header->channels, 4);
+	storeLittle (field + 20, 0, 4); 														/*Reserved*/
+
+	return writeAll (output, (const char*)field, BINARY_HEADER_SIZE);
+
+}
+
+/* Read the header of a binary file from file 'input' into 'header' */
+
+STATUS acquireHeaderFromFile (const int input, binaryHeader * const header) {
+
+	unsigned char field[BINARY_HEADER_SIZE];
+	struct stat status;
+	unsigned long long values; 																/*Doubles of a frame, evaluated without overflows*/
+
+	if (readAll (input, (char*)field, BINARY_HEADER_SIZE) != OK) return EOF_REACHED;
+
+	if (loadLittle (field, 4) != BINARY_MAGIC || loadLittle (field + 4, 2) != BINARY_VERSION || loadLittle (field + 6, 2) > SAMPLE_COMPLEX ||
+		loadLittle (field + 8, 4) == 0 || loadLittle (field + 16, 4) == 0) {
+		return BAD_FORMAT;
+	}
+
+	values = (unsigned long long)loadLittle (field + 8, 4)*loadLittle (field + 16, 4)*((loadLittle (field + 6, 2) == SAMPLE_COMPLEX) ? 2 : 1);
+	if (values > BINARY_MAX_VALUES) return BAD_FORMAT;
+	if (fstat (input, &status) == OK && S_ISREG (status.st_mode) && 						/*Not even a frame in a regular file: a corrupted header*/
+		(unsigned long long)status.st_size < BINARY_HEADER_SIZE + values*sizeof (double)) {
+		return BAD_FORMAT;
+	}
+
+	header->type = (sampleType)loadLittle (field + 6, 2);
+	header->length = loadLittle (field + 8, 4);
+	header->rate = loadLittle (field + 12, 4);
+	header->channels = loadLittle (field + 16, 4);
+
+	return OK;
+
+}
+
+/* Return the number of doubles of a frame of a binary file described by 'header' */
+
+unsigned int binaryValues (const binaryHeader * const header) {
+
+	const unsigned long long values = (unsigned long long)header->length*header->channels*((header->type == SAMPLE_COMPLEX) ? 2 : 1);
+
+	return (values > BINARY_MAX_VALUES) ? 0 : (unsigned int)values;
+
+}
+
+/* Send 'n' doubles taken from 'values' to file 'output', in little-endian order */
+
+STATUS sendBinaryToFile (const int output, const double * const values, const unsigned int n) {
+
+	double *block; 																			/*2 KB: too much for the stack of a periodic task*/
+	unsigned int count;
+	STATUS st = OK;
+
+	unsigned int index;
+
+	if (littleEndian()) return writeAll (output, (const char*)values, n*sizeof (double)); 	/*No conversions: the frame is written as it is*/
+
+	if ((block = (double*)malloc (BINARY_BLOCK*sizeof (double))) == NULL) return ERROR;
+
+	for (index = 0; index < n && st == OK; index += count) { 								/*Values are swapped in a copy, a block at a time*/
+		count = (n - index < BINARY_BLOCK) ? n - index : BINARY_BLOCK;
+		frmcpy (values + index, block, count);
+		swapBytes (block, count);
+		st = writeAll (output, (const char*)block, count*sizeof (double));
+	}
+
+	free (block);
+
+	return st;
+
+}
+
+/* Acquire 'n' doubles from file 'input', in little-endian order, and put them into 'values' */
+
+STATUS acquireFromBinaryFile (const int input, double * const values, const unsigned int n) {
+
+	if (readAll (input, (char*)values, n*sizeof (double)) != OK) return EOF_REACHED;
+
+	if (!littleEndian()) swapBytes (values, n);
+
+	return OK;
+
+}
+
+/* Create an encoder of frames of 'bins' bins of 'type', quantized to multiples of 'precision', and write its header to file 'output' */
+
+spectrumCodec* encoderCreate (const int output, const sampleType type, const unsigned int bins, const double precision) {
+
+	spectrumCodec *encoder;
+	unsigned char field[CODEC_HEADER_SIZE];
+	unsigned long long bits;
+
+	if ((encoder = codecCreate (output, type, bins, precision)) == NULL) return NULL;
+
+	memcpy (&bits, &precision, sizeof (double));
+	storeLittle (field, CODEC_MAGIC, 4);
+	storeLittle (field + 4, CODEC_VERSION, 2);
+	storeLittle (field + 6, (unsigned int)type, 2);
+	storeLittle (field + 8, bins, 4);
+	storeLittle (field + 12, (unsigned int)bits, 4);
+	storeLittle (field + 16, (unsigned int)(bits >> 32), 4);
+	storeLittle (field + 20, 0, 4); 														/*Reserved*/
+
+	if (writeAll (output, (const char*)field, CODEC_HEADER_SIZE) == ERROR) {
+		codecDestroy (encoder);
+		return NULL;
+	}
+	encoder->bytes = CODEC_HEADER_SIZE;
+
+	return encoder;
+
+}
+
+/* Send the frame of 'encoder->values' doubles taken from 'values', as a single record */
+
+STATUS sendToEncoder (spectrumCodec * const encoder, const double * const values) {
+
+	long long * const current = encoder->current;
+	long long * const previous = encoder->previous;
+	unsigned char *packed = encoder->record + 4; 											/*After the size of the record*/
+	unsigned long long raw, delta, bits;
+	unsigned int width, filled, count;
+	boolean differences;
+
+	unsigned int first, i;
+	for (first = 0; first < encoder->values; first += count) {
+		count = (encoder->values - first < CODEC_BLOCK) ? encoder->values - first : CODEC_BLOCK;
+		raw = 0;
+		delta = 0;
+		for (i = first; i < first + count; i++) { 											/*The widest value decides the width of the block*/
+			current[i] = quantize (values[i]*encoder->scale);
+			raw |= zigzag (current[i]);
+			delta |= zigzag (current[i] - previous[i]);
+		}
+		differences = (delta < raw); 														/*Never wider than the quantized values*/
+		width = bitWidth (differences ? delta : raw);
+		*packed++ = (unsigned char)(width | (differences ? CODEC_DELTA : 0));
+		bits = 0;
+		filled = 0;
+		for (i = first; i < first + count; i++) { 											/*At most 7 bits are pending before each value*/
+			bits |= zigzag (differences ? current[i] - previous[i] : current[i]) << filled;
+			filled += width;
+			while (filled >= 8) {
+				*packed++ = (unsigned char)bits;
+				bits >>= 8;
+				filled -= 8;
+			}
+		}
+		if (filled > 0) *packed++ = (unsigned char)bits; 									/*Blocks end on a byte*/
+	}
+
+	count = (unsigned int)(packed - encoder->record);
+	storeLittle (encoder->record, count - 4, 4);
+	encoder->current = previous; 															/*This frame is the reference of the next one*/
+	encoder->previous = current;
+	encoder->frames++;
+	encoder->bytes += count;
+
+	return writeAll (encoder->device, (const char*)encoder->record, count);
+
+}
+
+/* Read the header of the compressed file 'input' and create its decoder */
+
+spectrumCodec* decoderCreate (const int input) {
+
+	unsigned char field[CODEC_HEADER_SIZE];
+	unsigned long long bits;
+	double precision;
+	spectrumCodec *decoder;
+
+	if (readAll (input, (char*)field, CODEC_HEADER_SIZE) != OK) return NULL;
+	if (loadLittle (field, 4) != CODEC_MAGIC || loadLittle (field + 4, 2) != CODEC_VERSION) return NULL;
+
+	bits = (unsigned long long)loadLittle (field + 12, 4) | ((unsigned long long)loadLittle (field + 16, 4) << 32);
+	memcpy (&precision, &bits, sizeof (double));
+
+	if ((decoder = codecCreate (input, (sampleType)loadLittle (field + 6, 2), loadLittle (field + 8, 4), precision)) == NULL) return NULL;
+	decoder->bytes = CODEC_HEADER_SIZE;
+
+	return decoder;
+
+}
+
+/* Acquire the next frame of 'decoder' and put its values into 'values' */
+
+STATUS acquireFromDecoder (spectrumCodec * const decoder, double * const values) {
+
+	long long * const current = decoder->current;
+	long long * const previous = decoder->previous;
+	const unsigned char *packed = decoder->record;
+	const unsigned char *end;
+	unsigned long long bits;
+	unsigned int size, width, filled, count;
+	boolean differences;
+
+	unsigned int first, i;
+
+	if (readAll (decoder->device, (char*)decoder->record, 4) != OK) return EOF_REACHED;
+	if ((size = loadLittle (decoder->record, 4)) > decoder->size - 4) return BAD_FORMAT;
+	if (readAll (decoder->device, (char*)decoder->record, size) != OK) return EOF_REACHED;
+	end = packed + size;
+
+	for (first = 0; first < decoder->values; first += count) {
+		count = (decoder->values - first < CODEC_BLOCK) ? decoder->values - first : CODEC_BLOCK;
+		if (packed == end) return BAD_FORMAT;
+		width = *packed & ~CODEC_DELTA;
+		differences = (*packed++ & CODEC_DELTA) != 0;
+		if (width > CODEC_WIDTH || (count*width + 7)/8 > (unsigned int)(end - packed)) return BAD_FORMAT;
+		bits = 0;
+		filled = 0;
+		for (i = first; i < first + count; i++) {
+			while (filled < width) { 														/*At most 7 bits are left over*/
+				bits |= (unsigned long long)*packed++ << filled;
+				filled += 8;
+			}
+			current[i] = unzigzag (bits & ((1ULL << width) - 1));
+			if (differences) current[i] += previous[i];
+			bits >>= width;
+			filled -= width;
+			values[i] = current[i]*decoder->precision;
+		}
+	}
+
+	decoder->current = previous;
+	decoder->previous = current;
+	decoder->frames++;
+	decoder->bytes += 4 + size;
+
+	return OK;
+
+}
+
+/* Release an encoder or a decoder obtained by encoderCreate(); or decoderCreate(); */
+
+void codecDestroy (spectrumCodec * const codec) {
+
+	free (codec->previous);
+	free (codec->current);
+	free (codec->record);
+	free (codec);
+
+}
+
+/* Write in 'buffer' the line of 'value' in the format of sendToWriter();, and return its length */
+
+unsigned int formatLine (char * const buffer, const complex * const value) {
+
+	char *c = buffer;
+
+	if (value->real < MAX_ABSOLUTE_VALUE && value->imag < MAX_ABSOLUTE_VALUE && value->real > -FORMAT_LIMIT && value->imag > -FORMAT_LIMIT) {
+		c += formatFixed (c, value->real);
+		memcpy (c, " + j(", 5);
+		c += 5;
+		c += formatFixed (c, value->imag);
+		*c++ = ')';
+	}
+	else {
+		memcpy (c, "NaN", 3); 																/*IEEE arithmetic representation for Not a Number*/
+		c += 3;
+	}
+	*c++ = '\n';
+
+	return (unsigned int)(c - buffer);
+
+}
+
+/* Write in 'buffer' the line of 'value' in the format of sendRealToWriter();, and return its length */
+
+unsigned int formatRealLine (char * const buffer, const double value) {
+
+	const unsigned int len = formatFixed (buffer, value); 									/*Up to FORMAT_LIMIT, unlike the samples of complex lines*/
+
+	buffer[len] = '\n';
+
+	return len + 1;
+
+}
+
+/* Create a buffered writer of file 'output' with a block buffer of 'size' characters */
+
+fileWriter* writerCreate (const int output, const unsigned int size) {
+
+	fileWriter *writer;
+
+	if (size < MAX_LINE_LENGTH) return NULL;
+
+	writer = (fileWriter*)malloc (sizeof (fileWriter));
+	if (writer == NULL) return NULL;
+
+	writer->block = (char*)malloc (size);
+	if (writer->block == NULL) {
+		free (writer);
+		return NULL;
+	}
+
+	writer->output = output;
+	writer->size = size;
+	writer->used = 0;
+
+	return writer;
+
+}
+
+/* Send 'n' complex data taken from 'frameF' to 'writer' */
+
+STATUS sendToWriter (fileWriter * const writer, const complex * const frameF, const unsigned int n) {
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+		if (writer->size - writer->used < MAX_LINE_LENGTH && flushWriter (writer) == ERROR) return ERROR;
+		writer->used += formatLine (writer->block + writer->used, &frameF[index]);
+	}
+
+	return flushWriter (writer); 															/*A single write(); if the whole frame fits the block*/
+
+}
+
+/* Send 'n' real data taken from 'frameR' to 'writer' */
+
+STATUS sendRealToWriter (fileWriter * const writer, const double * const frameR, const unsigned int n) {
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+		if (writer->size - writer->used < MAX_LINE_LENGTH && flushWriter (writer) == ERROR) return ERROR;
+		writer->used += formatRealLine (writer->block + writer->used, frameR[index]);
+	}
+
+	return flushWriter (writer);
+
+}
+
+/* Release a buffered writer obtained by writerCreate(); */
+
+void writerDestroy (fileWriter * const writer) {
+
+	free (writer->block);
+	free (writer);
+
+}
+
+/* Init UDP connection structure. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
+
+STATUS initUDP (const int UDPSocket, char * const ip, const unsigned int port) {
+
+	int sockAddrSize = sizeof (struct sockaddr_in); 										/*Size of socket address structure*/
+
+	/*bzero ((char*)&serverAddr, sockAddrSize);*/
+	serverAddr.sin_len = (u_char)sockAddrSize;
+	serverAddr.sin_family = AF_INET;
+	serverAddr.sin_port = htons (port);
+
+	if ((serverAddr.sin_addr.s_addr = inet_addr (ip)) == ERROR &&
+		(serverAddr.sin_addr.s_addr = hostGetByName (ip)) == ERROR) {
+		close (UDPSocket);
+		return ERROR;
+	}
+
+	return OK;
+
+}
+
+/* Send 'n' double data taken from 'frameT' to 'UDPSocket'. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
+
+STATUS sendToUDP (const int UDPSocket, const double * const frameT, const unsigned int n) {
+
+	char buffer[MAX_CHARACTERS+2]; 															/*It may contain for instance '-10.6887\n\0'*/
+	int len;
+
+	unsigned int index;
+
+	for (index = 0; index < n; index++) {
+
+		len = sprintf (buffer, "%+.4f\n", frameT[index]);
+
+		if ((len = sendto (UDPSocket, buffer, len, 0, (struct sockaddr*)&serverAddr, (int)serverAddr.sin_len)) == ERROR) {
+			close (UDPSocket);
+			return ERROR;
+		}
+
+	}
+
+	return OK;
+
+}
+
+/* Create a sender of UDP frames to 'ip' and 'port', through 'UDPSocket' */
+
+udpSender* senderCreate (const int UDPSocket, char * const ip, const unsigned int port) {
+
+	udpSender *sender;
+
+	sender = (udpSender*)calloc (1, sizeof (udpSender)); 									/*Pointers start NULL: senderDestroy(); can be called at any point*/
+	if (sender == NULL) return NULL;
+
+	sender->socket = UDPSocket;
+	sender->address.sin_len = (u_char)sizeof (struct sockaddr_in);
+	sender->address.sin_family = AF_INET;
+	sender->address.sin_port = htons (port);
+	sender->sequence = 0;
+	sender->frame = 0;
+
+	if ((sender->address.sin_addr.s_addr = inet_addr (ip)) == ERROR &&
+		(sender->address.sin_addr.s_addr = hostGetByName (ip)) == ERROR) {
+		senderDestroy (sender);
+		return NULL;
+	}
+
+	sender->headers = (unsigned char*)malloc (UDP_BATCH*DATAGRAM_HEADER_SIZE);
+	sender->vectors = (struct iovec*)malloc (2*UDP_BATCH*sizeof (struct iovec));
+	sender->messages = calloc (UDP_BATCH, sizeof (datagramMessage));
+	if (!littleEndian()) sender->payloads = (double*)malloc (UDP_BATCH*DATAGRAM_SAMPLES*sizeof (double));
+
+	if (sender->headers == NULL || sender->vectors == NULL || sender->messages == NULL || (!littleEndian() && sender->payloads == NULL)) {
+		senderDestroy (sender);
+		return NULL;
+	}
+
+	return sender;
+
+}
+
+/* Send 'n' double data taken from 'frameT' to the receiver of 'sender', as a UDP frame */
+
+STATUS sendFrameToUDP (udpSender * const sender, const double * const frameT, const unsigned int n) {
+
+	datagramMessage * const messages = (datagramMessage*)sender->messages;
+
+	unsigned char *header;
+	struct iovec *vector;
+	unsigned int count;
+	unsigned int batch;
+	unsigned int offset = 0;
+	int sent;
+
+	unsigned int i;
+
+	while (offset < n) {
+
+		for (batch = 0; batch < UDP_BATCH && offset < n; batch++) { 						/*Build the next batch of datagrams*/
+			count = (n - offset < DATAGRAM_SAMPLES) ? n - offset : (unsigned int)DATAGRAM_SAMPLES;
+			header = sender->headers + batch*DATAGRAM_HEADER_SIZE;
+			storeLittle (header, DATAGRAM_MAGIC, 4);
+			storeLittle (header + 4, sender->sequence++, 4);
+			storeLittle (header + 8, sender->frame, 4);
+			storeLittle (header + 12, n, 4);
+			storeLittle (header + 16, offset, 4);
+			storeLittle (header + 20, count, 4);
+			vector = sender->vectors + 2*batch;
+			vector[0].iov_base = (char*)header;
+			vector[0].iov_len = DATAGRAM_HEADER_SIZE;
+			if (littleEndian()) vector[1].iov_base = (char*)(frameT + offset); 				/*Gathered straight from the frame*/
+			else {
+				vector[1].iov_base = (char*)(sender->payloads + batch*DATAGRAM_SAMPLES);
+				frmcpy (frameT + offset, sender->payloads + batch*DATAGRAM_SAMPLES, count);
+				swapBytes (sender->payloads + batch*DATAGRAM_SAMPLES, count);
+			}
+			vector[1].iov_len = count*sizeof (double);
+			messages[batch].msg_hdr.msg_name = (char*)&sender->address;
+			messages[batch].msg_hdr.msg_namelen = sizeof (struct sockaddr_in);
+			messages[batch].msg_hdr.msg_iov = vector;
+			messages[batch].msg_hdr.msg_iovlen = 2;
+			offset += count;
+		}
+
+		for (i = 0; i < batch; i += (unsigned int)sent) { 									/*Batched calls may send only some of the datagrams*/
+			if ((sent = sendBatch (sender->socket, messages + i, batch - i)) <= 0) {
+				sender->frame++;
+				return ERROR;
+			}
+		}
+
+	}
+
+	sender->frame++;
+
+	return OK;
+
+}
+
+/* Release a sender of UDP frames obtained by senderCreate(); */
+
+void senderDestroy (udpSender * const sender) {
+
+	free (sender->headers);
+	free (sender->payloads);
+	free (sender->vectors);
+	free (sender->messages);
+	free (sender);
+
+}
+
+/* Create a receiver of UDP frames bound to 'port' through 'UDPSocket', with a window of 'capacity' samples */
+
+udpReceiver* receiverCreate (const int UDPSocket, const unsigned int port, const unsigned int capacity, const unsigned int slack,
+	const unsigned int timeout) {
+
+	udpReceiver *receiver;
+	datagramMessage *messages;
+	struct sockaddr_in address;
+
+	unsigned int i;
+
+	if (capacity <= slack) return NULL;
+
+	memset (&address, 0, sizeof (address));
+	address.sin_len = (u_char)sizeof (struct sockaddr_in);
+	address.sin_family = AF_INET;
+	address.sin_port = htons (port);
+	address.sin_addr.s_addr = htonl (INADDR_ANY);
+
+	if (bind (UDPSocket, (struct sockaddr*)&address, sizeof (address)) == ERROR) return NULL;
+
+	receiver = (udpReceiver*)calloc (1, sizeof (udpReceiver)); 								/*Counters start from 0, pointers NULL*/
+	if (receiver == NULL) return NULL;
+
+	receiver->socket = UDPSocket;
+	receiver->capacity = capacity;
+	receiver->slack = slack;
+	receiver->started = false;
+	receiver->silence = ((ULONG)timeout*sysClkRateGet() + 999)/1000;
+	receiver->last = tickGet();
+	receiver->window = (double*)malloc (capacity*sizeof (double));
+	receiver->filled = (unsigned char*)calloc (capacity, 1);
+	receiver->samples = (double*)malloc (DATAGRAM_SAMPLES*sizeof (double));
+	receiver->datagrams = (char*)malloc (UDP_BATCH*UDP_PAYLOAD);
+	receiver->vectors = (struct iovec*)malloc (UDP_BATCH*sizeof (struct iovec));
+	receiver->messages = calloc (UDP_BATCH, sizeof (datagramMessage));
+
+	if (receiver->window == NULL || receiver->filled == NULL || receiver->samples == NULL || receiver->datagrams == NULL ||
+		receiver->vectors == NULL || receiver->messages == NULL) {
+		receiverDestroy (receiver);
+		return NULL;
+	}
+
+	messages = (datagramMessage*)receiver->messages;
+	for (i = 0; i < UDP_BATCH; i++) { 														/*Buffers never change: messages are set once*/
+		receiver->vectors[i].iov_base = receiver->datagrams + i*UDP_PAYLOAD;
+		receiver->vectors[i].iov_len = UDP_PAYLOAD;
+		messages[i].msg_hdr.msg_iov = receiver->vectors + i;
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return receiver;
+
+}
+
+/* Acquire the next 'n' samples of the stream from 'receiver' and put them into 'frameT' */
+
+STATUS acquireFromUDP (udpReceiver * const receiver, double * const frameT, const unsigned int n) {
+
+	datagramMessage * const messages = (datagramMessage*)receiver->messages;
+
+	unsigned int scan = 0; 																	/*Samples of the frame known to be received*/
+	unsigned int index;
+	int count;
+	STATUS st = OK;
+
+	int i;
+
+	if (n > receiver->capacity - receiver->slack) return ERROR;
+
+	while (true) {
+
+		while (receiver->started && scan < n && receiver->filled[(receiver->base + scan) % receiver->capacity]) scan++;
+		if (scan == n) break; 																/*The frame is complete...*/
+		if (receiver->started && receiver->end >= receiver->base + n + receiver->slack) { 	/*...or its gaps are given up*/
+			break;
+		}
+
+		if ((count = receiveBatch (receiver->socket, messages, UDP_BATCH)) == ERROR) {
+			if (tickGet() - receiver->last >= receiver->silence) return EOF_REACHED;
+			receiver->starved++; 															/*Back in the next period: no wait here*/
+			return FRAME_NOT_READY;
+		}
+		receiver->last = tickGet();
+		for (i = 0; i < count; i++) {
+			placeDatagram (receiver, (const char*)receiver->vectors[i].iov_base, messages[i].msg_len);
+			messages[i].msg_hdr.msg_flags = 0;
+		}
+
+	}
+
+	for (index = 0; index < n; index++) {
+		if (receiver->filled[(receiver->base + index) % receiver->capacity]) {
+			frameT[index] = receiver->window[(receiver->base + index) % receiver->capacity];
+			receiver->filled[(receiver->base + index) % receiver->capacity] = 0;
+		}
+		else {
+			frameT[index] = 0; 																/*Never arrived: given up*/
+			receiver->missing++;
+			st = MALFORMED_SAMPLE;
+		}
+	}
+
+	receiver->base += n;
+
+	return st;
+
+}
+
+/* Release a receiver of UDP frames obtained by receiverCreate(); */
+
+void receiverDestroy (udpReceiver * const receiver) {
+
+	free (receiver->window);
+	free (receiver->filled);
+	free (receiver->samples);
+	free (receiver->datagrams);
+	free (receiver->vectors);
+	free (receiver->messages);
+	free (receiver);
+
+}
+
+/* Decode the datagram of 'size' bytes contained in 'datagram' */
+
+STATUS decodeDatagram (const char * const datagram, const unsigned int size, datagramHeader * const header, double * const samples) {
+
+	const unsigned char * const field = (const unsigned char*)datagram;
+
+	if (size < DATAGRAM_HEADER_SIZE || loadLittle (field, 4) != DATAGRAM_MAGIC) return BAD_FORMAT;
+
+	header->sequence = loadLittle (field + 4, 4);
+	header->frame = loadLittle (field + 8, 4);
+	header->length = loadLittle (field + 12, 4);
+	header->offset = loadLittle (field + 16, 4);
+	header->count = loadLittle (field + 20, 4);
+
+	if (header->count > DATAGRAM_SAMPLES || size != DATAGRAM_HEADER_SIZE + header->count*sizeof (double) || header->offset > header->length ||
+		header->count > header->length - header->offset) {
+		return BAD_FORMAT;
+	}
+
+	memcpy (samples, datagram + DATAGRAM_HEADER_SIZE, header->count*sizeof (double)); 		/*The payload may be unaligned*/
+	if (!littleEndian()) swapBytes (samples, header->count);
+
+	return OK;
+
+}
+
+/* Copy a frame 'frameIn' into another 'frameOut' with the same length 'n' */
+
+void frmcpy (const double * const frameIn, double * const frameOut, const unsigned int n) {
+	
+	unsigned int index;
+	
+	for (index = 0; index < n; index++) {
+		
+		frameOut[index] = frameIn[index];
+		
+	}
+	
+}
@@ -1,46 +1,425 @@
-/*
- * This library provides functions to interface DSP computations towards extern devices
- * Author: Alessandro Trifoglio
- * Last revision: 22/12/2016
- */
-
-#ifndef DSPIO_H
-#define DSPIO_H
-
-/* Parent library */
-
-#include "dsp.h"
-
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Messages (STATUS) */
-
-#define EOF_REACHED 								0x776a7db0
-
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-/* ---------------------------------------------------------- IO functions used to access devices ---------------------------------------------------------- */
-/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
-
-/* Acquire 'n' data from file 'input' and put them into 'frameT' */
-
-STATUS acquireFromFile (const int input, double * const frameT, const unsigned int n);
-
-/* Send 'n' complex data taken from 'frameF' to file 'output' */
-
-void sendToFile (const int output, const complex * const frameF, const unsigned int n);
-
-/* Init UDP connection structure. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
-
-STATUS initUDP (const int UDPSocket, char * const ip, const unsigned int port);
-
-/* Send 'n' double data taken from 'frameT' to 'UDPSocket'. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
-
-STATUS sendToUDP (const int UDPSocket, const double * const frameT, const unsigned int n);
-
-/* Copy a frame 'frameIn' into another 'frameOut' with the same length 'n' */
-
-void frmcpy (const double * const frameIn, double * const frameOut, const unsigned int n);
-
-#endif
+/*
+ * This library provides functions to interface DSP computations towards extern devices
+ * Author: Alessandro Trifoglio
+ * Last revision: 22/12/2016
+ */
+
+#ifndef DSPIO_H
+#define DSPIO_H
+
+/* Parent library */
+
+#include "dsp.h"
+
+/* VxWorks common libraries */
+
+#include "sockLib.h" 								/*Generic socket library*/
+#include "inetLib.h" 								/*Internet address manipulation routines*/
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Messages (STATUS) */
+
+#define EOF_REACHED 								0x776a7db0
+#define MALFORMED_SAMPLE 							0x3d5e92c4
+#define BAD_FORMAT 									0x1fa8c65e
+#define FRAME_NOT_READY 							0x6a0c3f75
+
+/* Default size of the block buffer of a fileReader: a refill brings in about 1600 samples of the '%+.4f' format */
+
+#define READER_BLOCK 								16384
+
+/* Default size of the block buffer of a fileWriter (a spectrum of 129 bins takes about 3300 characters), and maximum length of a line it writes */
+
+#define WRITER_BLOCK 								8192
+#define MAX_LINE_LENGTH 							48
+
+/* Limit of the values written by formatFixed(); (their scaled value must fit the mantissa of a double) */
+
+#define FORMAT_LIMIT 								1e11
+
+/* Maximum number of digits of a sample parsed by parseFixed(); (the mantissa must fit an unsigned long long) */
+
+#define MAX_DIGITS 									18
+
+/* Binary files: 'DSPF' as a little-endian integer, version of the format, size of the header, doubles converted at a time on big-endian processors and
+ * maximum doubles of a frame (2^26, 512 MB): headers describing larger frames are rejected, so that the size of a frame never overflows */
+
+#define BINARY_MAGIC 								0x46505344
+#define BINARY_VERSION 								1
+#define BINARY_HEADER_SIZE 							24
+#define BINARY_BLOCK 								256
+#define BINARY_MAX_VALUES 							0x4000000
+
+/* UDP frames: payload of a datagram fitting an Ethernet MTU (1500 bytes, less IP and UDP headers), size of the header of each datagram, samples carried
+ * by a datagram, datagrams submitted by a single call and 'DSPU' as a little-endian integer */
+
+#define UDP_PAYLOAD 								1472
+#define DATAGRAM_HEADER_SIZE 						24
+#define DATAGRAM_SAMPLES 							((UDP_PAYLOAD - DATAGRAM_HEADER_SIZE)/sizeof (double))
+#define UDP_BATCH 									32
+#define DATAGRAM_MAGIC 								0x55505344
+
+/* Compressed spectra: 'DSPZ' as a little-endian integer, version of the format, size of the header, values of a block (packed with the same width) and
+ * maximum width of a packed value (quantized values are limited to 2^50 in magnitude, so that their zigzag-coded differences fit it) */
+
+#define CODEC_MAGIC 								0x5a505344
+#define CODEC_VERSION 								1
+#define CODEC_HEADER_SIZE 							24
+#define CODEC_BLOCK 								32
+#define CODEC_WIDTH 								53
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Buffered reader of a text file: a single read(); fills the block buffer, which is then scanned line by line. The partial line left at the end of the
+ * block is moved to its front before the next refill, so that lines (samples) split across refills are seen whole */
+
+typedef struct fileReader {
+
+	int input; 										/*Handle of the file (not owned by the reader)*/
+	char *block; 									/*Block buffer: 'size' characters, plus a terminator*/
+	unsigned int size; 								/*Size of the block buffer*/
+	unsigned int first; 							/*First character not scanned yet*/
+	unsigned int last; 								/*One past the last character read*/
+	boolean eof; 									/*Set when read(); has reported the end of file*/
+
+} fileReader;
+
+/* Buffered writer of a text file: whole frames are formatted into the block buffer, which is flushed by a single write(); at the end of each frame (or
+ * when it's full) */
+
+typedef struct fileWriter {
+
+	int output; 									/*Handle of the file (not owned by the writer)*/
+	char *block; 									/*Block buffer*/
+	unsigned int size; 								/*Size of the block buffer*/
+	unsigned int used; 								/*Characters waiting in the block buffer*/
+
+} fileWriter;
+
+/* Input file mapped into memory: samples are parsed straight out of the page cache, with a cursor advanced frame by frame. The kernel is advised of the
+ * sequential access, so that pages are read ahead of the cursor */
+
+typedef struct fileMapping {
+
+	char *start; 									/*First character of the mapping (NULL for empty files)*/
+	size_t size; 									/*Characters of the file*/
+	size_t cursor; 									/*First character not parsed yet*/
+
+} fileMapping;
+
+/* Types of the samples of binary files */
+
+typedef enum sampleType {
+	SAMPLE_REAL = 0, 								/*Doubles (for instance time samples or reduced spectra)*/
+	SAMPLE_COMPLEX = 1 								/*Complex values: real and imaginary part of each one (for instance spectra)*/
+} sampleType;
+
+/* Header of a binary file. On file it takes BINARY_HEADER_SIZE bytes: BINARY_MAGIC (4 bytes), BINARY_VERSION (2), type (2), length (4), rate (4),
+ * channels (4) and 4 reserved bytes, all little-endian. The payload follows: frames of 'length' samples for each channel (channel after channel), as
+ * little-endian doubles */
+
+typedef struct binaryHeader {
+
+	sampleType type; 								/*Type of the samples*/
+	unsigned int length; 							/*Samples of a frame, for each channel*/
+	unsigned int rate; 								/*Sample rate (Hz)*/
+	unsigned int channels; 							/*Number of channels*/
+
+} binaryHeader;
+
+/* Header of a datagram of a UDP frame. On the wire it takes DATAGRAM_HEADER_SIZE bytes: DATAGRAM_MAGIC and the five fields below (4 bytes each), all
+ * little-endian. 'count' samples follow, as little-endian doubles */
+
+typedef struct datagramHeader {
+
+	unsigned int sequence; 							/*Datagrams sent before this one by the same sender: gaps reveal losses and reordering*/
+	unsigned int frame; 							/*Frames sent before this one by the same sender*/
+	unsigned int length; 							/*Samples of the whole frame*/
+	unsigned int offset; 							/*Index of the first sample carried, in the frame*/
+	unsigned int count; 							/*Samples carried (at most DATAGRAM_SAMPLES)*/
+
+} datagramHeader;
+
+/* Sender of UDP frames: each frame is split into datagrams of DATAGRAM_SAMPLES samples, which are submitted UDP_BATCH at a time by sendmmsg(); (one
+ * at a time by sendmsg(); where it isn't available). On little-endian processors payloads are gathered straight from the frame, with no copies */
+
+typedef struct udpSender {
+
+	int socket; 									/*UDP socket (not owned by the sender)*/
+	struct sockaddr_in address; 					/*Address of the receiver*/
+	unsigned int sequence; 							/*Sequence number of the next datagram*/
+	unsigned int frame; 							/*Number of the next frame*/
+
+	unsigned char *headers; 						/*Headers of a batch of datagrams*/
+	double *payloads; 								/*Payloads of a batch, byte-swapped (big-endian processors only)*/
+	struct iovec *vectors; 							/*Header and payload of each datagram of a batch*/
+	void *messages; 								/*Messages of a batch (struct mmsghdr where available)*/
+
+} udpSender;
+
+/* Receiver of UDP frames, acquiring a stream of samples: each datagram is placed at its position in the stream (frame*length+offset) in a window of
+ * 'capacity' samples, whatever the order of arrival. Datagrams are received UDP_BATCH at a time by recvmmsg(); (one at a time by recvmsg(); where it
+ * isn't available), without waiting for them. Gaps in the sequence numbers are counted as losses, until the missing datagrams arrive (then they count
+ * as reordered) */
+
+typedef struct udpReceiver {
+
+	int socket; 									/*UDP socket (not owned by the receiver)*/
+	unsigned int capacity; 							/*Samples of the window*/
+	unsigned int slack; 							/*Samples received beyond a frame after which its gaps are given up*/
+	double *window; 								/*Samples of the stream from 'base', at index 'position%capacity'*/
+	unsigned char *filled; 							/*Set for each sample of the window which has been received*/
+	unsigned long long base; 						/*Position of the first sample not acquired yet*/
+	unsigned long long end; 						/*One past the last position received*/
+	boolean started; 								/*Set by the first datagram, whose frame starts the stream*/
+	unsigned int next; 								/*Sequence number expected next*/
+	ULONG silence; 									/*Ticks without datagrams after which the stream is considered ended*/
+	ULONG last; 									/*Tick of the last datagram received (or of the creation)*/
+
+	unsigned int received; 							/*Datagrams received*/
+	unsigned int lost; 								/*Datagrams missing from the sequence*/
+	unsigned int reordered; 						/*Datagrams received after some of their successors*/
+	unsigned int dropped; 							/*Datagrams (or parts) discarded: malformed, late or beyond the window*/
+	unsigned int missing; 							/*Samples acquired as 0, since they never arrived*/
+	unsigned int starved; 							/*Acquisitions returning FRAME_NOT_READY*/
+
+	double *samples; 								/*Samples of the datagram being placed*/
+	char *datagrams; 								/*Buffers of a batch of datagrams, UDP_PAYLOAD bytes each*/
+	struct iovec *vectors; 							/*Buffer of each datagram of a batch*/
+	void *messages; 								/*Messages of a batch (struct mmsghdr where available)*/
+
+} udpReceiver;
+
+/* Encoder (or decoder) of compressed spectra. Each value is quantized to a multiple of 'precision', and blocks of CODEC_BLOCK values are packed with the
+ * width of their largest zigzag-coded value: either the quantized values or their differences from the previous frame, whichever are narrower. On file
+ * a header of CODEC_HEADER_SIZE bytes (CODEC_MAGIC (4 bytes), CODEC_VERSION (2), type (2), bins (4), precision (8, a double) and 4 reserved bytes, all
+ * little-endian) is followed by a record for each frame: its size (4 bytes) and, for each block, a byte with its width (plus 128 for differences) and
+ * its values, packed from the least significant bit */
+
+typedef struct spectrumCodec {
+
+	int device; 									/*Handle of the file (not owned by the codec)*/
+	sampleType type; 								/*Type of the bins*/
+	unsigned int bins; 								/*Bins of a frame*/
+	unsigned int values; 							/*Values of a frame (2 for each complex bin)*/
+	double precision; 								/*Quantization step: values are restored within 'precision/2'*/
+	double scale; 									/*Its inverse*/
+	long long *previous; 							/*Quantized values of the previous frame (0 before the first one)*/
+	long long *current; 							/*Quantized values of the frame being coded*/
+	unsigned char *record; 							/*Record of a frame*/
+	unsigned int size; 								/*Maximum size of a record*/
+
+	unsigned int frames; 							/*Frames coded*/
+	unsigned long long bytes; 						/*Bytes written or read, header included*/
+
+} spectrumCodec;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------- IO functions used to access devices ---------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Parse a sample written in fixed-point decimal text (for instance '-10.6887', the '%+.4f' format of the input files): optional blanks and sign, digits
+ * with an optional '.' (never the separator of the locale) and at least one digit, optional blanks and '\r'. The text ends at '\0' or '\n', so that
+ * samples can be parsed straight out of a block of lines. The value is the integer mantissa divided by an exact power of 10: up to 15 significant digits
+ * it is correctly rounded (the same given by atof();). 'NaN' (written by the send functions) is accepted too. MALFORMED_SAMPLE is returned, and 'value' is
+ * set to 0, if the text doesn't follow this format or has more than MAX_DIGITS digits */
+
+STATUS parseFixed (const char * const text, double * const value);
+
+/* Parse a complex sample written as 'a + j(b)' (the format of sendToFile();), 'a' and 'b' as accepted by parseFixed();. 'NaN' sets both parts to NaN.
+ * MALFORMED_SAMPLE is returned, and 'value' is set to 0, if the text doesn't follow this format */
+
+STATUS parseComplex (const char * const text, complex * const value);
+
+/* Acquire 'n' data from file 'input' and put them into 'frameT'. Malformed samples are set to 0 and MALFORMED_SAMPLE is returned after the whole frame
+ * (see parseFixed();), unless the end of file is reached */
+
+STATUS acquireFromFile (const int input, double * const frameT, const unsigned int n);
+
+/* Create a buffered reader of file 'input' with a block buffer of 'size' characters (READER_BLOCK is a good default; lines longer than 'size' are split).
+ * The file is still closed by the caller. NULL is returned if 'size' is 0 or memory is exhausted. Call it outside the periodic activity */
+
+fileReader* readerCreate (const int input, const unsigned int size);
+
+/* Return the next line of 'reader' without its newline character, refilling the block buffer if needed. The line lives in the block buffer and is valid
+ * until the next call. NULL is returned at the end of file, also if the last line isn't terminated by a newline character */
+
+char* readerLine (fileReader * const reader);
+
+/* Acquire 'n' data from 'reader' and put them into 'frameT': the same of acquireFromFile();, with a read(); every READER_BLOCK characters instead of one
+ * for each character. EOF_REACHED is returned if the end of file is reached before 'n' complete lines, MALFORMED_SAMPLE if some of them has been set to 0 */
+
+STATUS acquireFromReader (fileReader * const reader, double * const frameT, const unsigned int n);
+
+/* Release a buffered reader obtained by readerCreate(); */
+
+void readerDestroy (fileReader * const reader);
+
+/* Map the whole file 'input' into memory (read-only), advising sequential access. The file is still closed by the caller, and may be closed as soon as
+ * the mapping is created. NULL is returned if 'input' can't be mapped or memory is exhausted. Call it outside the periodic activity */
+
+fileMapping* mappingCreate (const int input);
+
+/* Acquire 'n' data from 'mapping' and put them into 'frameT': the same values and statuses of acquireFromFile(); and acquireFromReader();, with no
+ * copies and no system calls */
+
+STATUS acquireFromMapping (fileMapping * const mapping, double * const frameT, const unsigned int n);
+
+/* Unmap and release a file mapping obtained by mappingCreate(); */
+
+void mappingDestroy (fileMapping * const mapping);
+
+/* Send 'n' complex data taken from 'frameF' to file 'output' */
+
+void sendToFile (const int output, const complex * const frameF, const unsigned int n);
+
+/* Send 'n' complex data taken from the split-complex frame 'frameS' to file 'output', converted a value at a time and sent by sendToFile(); */
+
+void sendSplitToFile (const int output, const splitFrame * const frameS, const unsigned int n);
+
+/* Send 'n' real data taken from 'frameR' (for instance a reduced spectrum) to file 'output', one value per line in the '%+.4f' format: reduced values
+ * (powers above all) may exceed the range of the samples of complex lines, so only values beyond FORMAT_LIMIT (and NaNs) are written as 'NaN' */
+
+void sendRealToFile (const int output, const double * const frameR, const unsigned int n);
+
+/* Write in 'buffer' the text of 'value' in the '%+.4f' format, without terminator, and return its length: the same characters of sprintf(); (rounding
+ * of ties to even included), for |value|<FORMAT_LIMIT. Larger values and NaNs are written as 'NaN' */
+
+unsigned int formatFixed (char * const buffer, const double value);
+
+/* Write in 'buffer' the line of 'value' in the format of sendToWriter(); (newline included, no terminator) and return its length, at most
+ * MAX_LINE_LENGTH characters */
+
+unsigned int formatLine (char * const buffer, const complex * const value);
+
+/* Write in 'buffer' the line of 'value' in the format of sendRealToWriter(); (newline included, no terminator) and return its length, at most
+ * MAX_LINE_LENGTH characters */
+
+unsigned int formatRealLine (char * const buffer, const double value);
+
+/* Create a buffered writer of file 'output' with a block buffer of 'size' characters (WRITER_BLOCK is a good default, at least MAX_LINE_LENGTH). The
+ * file is still closed by the caller. NULL is returned if 'size' is too small or memory is exhausted. Call it outside the periodic activity */
+
+fileWriter* writerCreate (const int output, const unsigned int size);
+
+/* Send 'n' complex data taken from 'frameF' to 'writer': the same text of sendToFile(); for values in range, with a single write(); if the frame fits the
+ * block buffer. Bins with a part lower than -1e11 are written as 'NaN' as well. ERROR is returned if the text can't be written */
+
+STATUS sendToWriter (fileWriter * const writer, const complex * const frameF, const unsigned int n);
+
+/* Send 'n' real data taken from 'frameR' to 'writer': the same text of sendRealToFile();, with a single write(); if the frame fits the block buffer.
+ * ERROR is returned if the text can't be written */
+
+STATUS sendRealToWriter (fileWriter * const writer, const double * const frameR, const unsigned int n);
+
+/* Release a buffered writer obtained by writerCreate(); */
+
+void writerDestroy (fileWriter * const writer);
+
+/* Write the header of a binary file to file 'output'. ERROR is returned if it can't be written */
+
+STATUS sendHeaderToFile (const int output, const binaryHeader * const header);
+
+/* Read the header of a binary file from file 'input' into 'header'. EOF_REACHED is returned if the file is shorter than a header, BAD_FORMAT if it isn't
+ * a binary file of this version, or its frames are empty, larger than BINARY_MAX_VALUES doubles or (for regular files) than the rest of the file */
+
+STATUS acquireHeaderFromFile (const int input, binaryHeader * const header);
+
+/* Return the number of doubles of a frame of a binary file described by 'header' (a complex sample counts 2), or 0 if they are more than
+ * BINARY_MAX_VALUES (only for headers not read by acquireHeaderFromFile();) */
+
+unsigned int binaryValues (const binaryHeader * const header);
+
+/* Send 'n' doubles taken from 'values' (for instance binaryValues(); of a frame) to file 'output', in little-endian order: on little-endian processors
+ * with a single write(); and no conversions, elsewhere by blocks swapped in a buffer taken from the heap (the stacks of periodic tasks are small). Complex
+ * frames are sent as doubles, casting them to (double*). ERROR is returned if they can't be written */
+
+STATUS sendBinaryToFile (const int output, const double * const values, const unsigned int n);
+
+/* Acquire 'n' doubles from file 'input', in little-endian order, and put them into 'values'. EOF_REACHED is returned if the file ends first */
+
+STATUS acquireFromBinaryFile (const int input, double * const values, const unsigned int n);
+
+/* Create an encoder of frames of 'bins' bins of 'type' (for instance spectra or reduced averages) quantized to multiples of 'precision' (0.0001 keeps
+ * the 4 decimals of the text output), and write its header to file 'output'. NULL is returned if 'bins' is 0, 'precision' isn't positive, the header
+ * can't be written or memory is exhausted. Call it outside the periodic activity */
+
+spectrumCodec* encoderCreate (const int output, const sampleType type, const unsigned int bins, const double precision);
+
+/* Send the frame of 'encoder->values' doubles taken from 'values' (complex frames are cast to (double*)), as a single record written by a single write();.
+ * Values beyond 2^50 quantization steps are clipped, NaNs are coded as 0. ERROR is returned if the record can't be written */
+
+STATUS sendToEncoder (spectrumCodec * const encoder, const double * const values);
+
+/* Read the header of the compressed file 'input' and create its decoder: type, bins and precision are set from the header. NULL is returned if 'input'
+ * isn't a compressed file of this version or memory is exhausted. Call it outside the periodic activity */
+
+spectrumCodec* decoderCreate (const int input);
+
+/* Acquire the next frame of 'decoder', reading its record only, and put its 'decoder->values' doubles into 'values', each one within 'precision/2' of the
+ * one sent. EOF_REACHED is returned if the file ends first, BAD_FORMAT if the record is corrupted (the following frames can't be decoded anymore) */
+
+STATUS acquireFromDecoder (spectrumCodec * const decoder, double * const values);
+
+/* Release an encoder or a decoder obtained by encoderCreate(); or decoderCreate();. The file is still closed by the caller */
+
+void codecDestroy (spectrumCodec * const codec);
+
+/* Init UDP connection structure. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
+
+STATUS initUDP (const int UDPSocket, char * const ip, const unsigned int port);
+
+/* Send 'n' double data taken from 'frameT' to 'UDPSocket'. Credits to: Daniel Casini, VxWorks UDP Communication Demo developed in ReTiS Lab, 28/11/2016 */
+
+STATUS sendToUDP (const int UDPSocket, const double * const frameT, const unsigned int n);
+
+/* Create a sender of UDP frames to 'ip' (address or host name) and 'port', through 'UDPSocket'. NULL is returned if the receiver is unknown or memory is
+ * exhausted. Call it outside the periodic activity */
+
+udpSender* senderCreate (const int UDPSocket, char * const ip, const unsigned int port);
+
+/* Send 'n' double data taken from 'frameT' to the receiver of 'sender', as a UDP frame of ceil(n/DATAGRAM_SAMPLES) datagrams (one system call every
+ * UDP_BATCH of them, where sendmmsg(); is available). ERROR is returned if a datagram can't be sent: the frame is counted anyway, and its datagrams
+ * not sent yet are lost */
+
+STATUS sendFrameToUDP (udpSender * const sender, const double * const frameT, const unsigned int n);
+
+/* Release a sender of UDP frames obtained by senderCreate(); */
+
+void senderDestroy (udpSender * const sender);
+
+/* Create a receiver of UDP frames bound to 'port' through 'UDPSocket', with a window of 'capacity' samples (at least the samples acquired at once, plus
+ * 'slack'). Gaps of a frame are given up when 'slack' samples beyond it have been received (a few datagrams, so that reordered ones are waited for),
+ * and the stream is considered ended if no datagram arrives for 'timeout' milliseconds. NULL is returned if 'port' can't be bound or memory is exhausted.
+ * Call it outside the periodic activity */
+
+udpReceiver* receiverCreate (const int UDPSocket, const unsigned int port, const unsigned int capacity, const unsigned int slack,
+	const unsigned int timeout);
+
+/* Acquire the next 'n' samples of the stream from 'receiver' and put them into 'frameT'. As for acquireFromFile();, EOF_REACHED is returned if no datagram
+ * has arrived for the timeout before the frame is complete, and MALFORMED_SAMPLE if samples given up have been set to 0. Unlike it, the calling task never
+ * waits: FRAME_NOT_READY is returned (and counted) if the frame isn't complete yet and no datagram is waiting, with the samples received so far kept for
+ * the next call, and ERROR if 'n' exceeds 'capacity-slack'. In both cases 'frameT' isn't changed, so callers must consider it acquired only when OK or
+ * MALFORMED_SAMPLE is returned (sourceAcquire(); of dspFrame.h does so), not just when EOF_REACHED isn't */
+
+STATUS acquireFromUDP (udpReceiver * const receiver, double * const frameT, const unsigned int n);
+
+/* Release a receiver of UDP frames obtained by receiverCreate(); */
+
+void receiverDestroy (udpReceiver * const receiver);
+
+/* Decode the datagram of 'size' bytes contained in 'datagram': its header is written in 'header', and its samples in 'samples' (up to DATAGRAM_SAMPLES).
+ * BAD_FORMAT is returned if it isn't a datagram of a UDP frame */
+
+STATUS decodeDatagram (const char * const datagram, const unsigned int size, datagramHeader * const header, double * const samples);
+
+/* Copy a frame 'frameIn' into another 'frameOut' with the same length 'n' */
+
+void frmcpy (const double * const frameIn, double * const frameOut, const unsigned int n);
+
+#endif
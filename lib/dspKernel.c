@@ -0,0 +1,695 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* H library */
+
+#include "dspKernel.h"
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Vectorized kernels are compiled only by GCC (4.9 or later) for x86 targets: they are enabled function by function, without global compiler flags */
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define X86_KERNELS
+#endif
+
+#ifdef X86_KERNELS
+
+/* Generic private libraries */
+
+#include "cpuid.h" 									/*For __get_cpuid(); utility*/
+#include "immintrin.h" 								/*x86 intrinsics*/
+
+/* CPUID feature flags */
+
+#define CPUID1_EDX_SSE2 							(1u << 26)
+#define CPUID1_ECX_FMA 								(1u << 12)
+#define CPUID1_ECX_OSXSAVE 							(1u << 27)
+#define CPUID1_ECX_AVX 								(1u << 28)
+#define CPUID7_EBX_AVX2 							(1u << 5)
+#define CPUID7_EBX_AVX512F 							(1u << 16)
+
+/* XCR0 flags: SSE and AVX register states (YMM), plus AVX-512 ones (ZMM), saved by the OS on context switches */
+
+#define XCR0_YMM 									0x00000006
+#define XCR0_ZMM 									0x000000e6
+
+#endif
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Scalar kernels -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Radix-2 butterflies */
+
+void butterflyScalar (complex * const a, complex * const b, const complex * const w, const unsigned int h) {
+
+	complex t;
+
+	unsigned int j;
+	for (j = 0; j < h; j++) {
+		t.real = b[j].real*w[j].real - b[j].imag*w[j].imag;
+		t.imag = b[j].real*w[j].imag + b[j].imag*w[j].real;
+		b[j].real = a[j].real - t.real;
+		b[j].imag = a[j].imag - t.imag;
+		a[j].real += t.real;
+		a[j].imag += t.imag;
+	}
+
+}
+
+/* Radix-2 butterflies on split-complex arrays */
+
+void butterflySplitScalar (double * const ar, double * const ai, double * const br, double * const bi, const double * const wr, const double * const wi,
+	const unsigned int h) {
+
+	double tr, ti;
+
+	unsigned int j;
+	for (j = 0; j < h; j++) {
+		tr = br[j]*wr[j] - bi[j]*wi[j];
+		ti = br[j]*wi[j] + bi[j]*wr[j];
+		br[j] = ar[j] - tr;
+		bi[j] = ai[j] - ti;
+		ar[j] += tr;
+		ai[j] += ti;
+	}
+
+}
+
+/* Radix-2 butterflies of a batch of frames */
+
+void butterflyBatchScalar (double * const ar, double * const ai, double * const br, double * const bi, const complex * const w, const unsigned int h,
+	const unsigned int width) {
+
+	double wr, wi, tr, ti;
+
+	unsigned int j, c, row;
+	for (j = 0, row = 0; j < h; j++, row += width) {
+		wr = w[j].real;
+		wi = w[j].imag;
+		for (c = row; c < row + width; c++) {
+			tr = br[c]*wr - bi[c]*wi;
+			ti = br[c]*wi + bi[c]*wr;
+			br[c] = ar[c] - tr;
+			bi[c] = ai[c] - ti;
+			ar[c] += tr;
+			ai[c] += ti;
+		}
+	}
+
+}
+
+/* Radix-2 butterflies in single precision */
+
+void butterflyFloatScalar (complexf * const a, complexf * const b, const complexf * const w, const unsigned int h) {
+
+	complexf t;
+
+	unsigned int j;
+	for (j = 0; j < h; j++) {
+		t.real = b[j].real*w[j].real - b[j].imag*w[j].imag;
+		t.imag = b[j].real*w[j].imag + b[j].imag*w[j].real;
+		b[j].real = a[j].real - t.real;
+		b[j].imag = a[j].imag - t.imag;
+		a[j].real += t.real;
+		a[j].imag += t.imag;
+	}
+
+}
+
+/* Twiddle multiplication */
+
+void multiplyScalar (complex * const x, const complex * const w, const unsigned int n) {
+
+	double real;
+
+	unsigned int j;
+	for (j = 0; j < n; j++) {
+		real = x[j].real*w[j].real - x[j].imag*w[j].imag;
+		x[j].imag = x[j].real*w[j].imag + x[j].imag*w[j].real;
+		x[j].real = real;
+	}
+
+}
+
+/* FIR filtering */
+
+void firScalar (const double * const x, const double * const h, const unsigned int m, double * const y, const unsigned int n) {
+
+	double sum;
+
+	unsigned int i, j;
+	for (i = 0; i < n; i++) {
+		sum = 0;
+		for (j = 0; j < m; j++) sum += h[j]*x[i + j];
+		y[i] += sum;
+	}
+
+}
+
+#ifdef X86_KERNELS
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- SSE2 kernels --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Product of complex values 'x' and 'w', each one held by a 128-bit register as [real, imag] */
+
+static inline __attribute__((target("sse2"))) __m128d mulSSE2 (const __m128d x, const __m128d w) {
+
+	const __m128d wr = _mm_unpacklo_pd (w, w); 												/*[w.real, w.real]*/
+	const __m128d wi = _mm_unpackhi_pd (w, w); 												/*[w.imag, w.imag]*/
+	const __m128d xs = _mm_shuffle_pd (x, x, 1); 											/*[x.imag, x.real]*/
+
+	return _mm_add_pd (_mm_mul_pd (x, wr), _mm_xor_pd (_mm_mul_pd (xs, wi), _mm_set_pd (0.0, -0.0)));
+
+}
+
+/* Radix-2 butterflies (one complex value per register) */
+
+__attribute__((target("sse2"))) void butterflySSE2 (complex * const a, complex * const b, const complex * const w, const unsigned int h) {
+
+	__m128d x, t;
+
+	unsigned int j;
+	for (j = 0; j < h; j++) {
+		t = mulSSE2 (_mm_loadu_pd (&b[j].real), _mm_loadu_pd (&w[j].real));
+		x = _mm_loadu_pd (&a[j].real);
+		_mm_storeu_pd (&b[j].real, _mm_sub_pd (x, t));
+		_mm_storeu_pd (&a[j].real, _mm_add_pd (x, t));
+	}
+
+}
+
+/* Radix-2 butterflies on split-complex arrays (two values per register, the remainder is processed by scalar code) */
+
+__attribute__((target("sse2"))) void butterflySplitSSE2 (double * const ar, double * const ai, double * const br, double * const bi, const double * const wr,
+	const double * const wi, const unsigned int h) {
+
+	__m128d xr, xi, yr, yi, vr, vi, tr, ti;
+
+	unsigned int j;
+	for (j = 0; j + 2 <= h; j += 2) {
+		yr = _mm_loadu_pd (&br[j]);
+		yi = _mm_loadu_pd (&bi[j]);
+		vr = _mm_loadu_pd (&wr[j]);
+		vi = _mm_loadu_pd (&wi[j]);
+		tr = _mm_sub_pd (_mm_mul_pd (yr, vr), _mm_mul_pd (yi, vi));
+		ti = _mm_add_pd (_mm_mul_pd (yr, vi), _mm_mul_pd (yi, vr));
+		xr = _mm_loadu_pd (&ar[j]);
+		xi = _mm_loadu_pd (&ai[j]);
+		_mm_storeu_pd (&br[j], _mm_sub_pd (xr, tr));
+		_mm_storeu_pd (&bi[j], _mm_sub_pd (xi, ti));
+		_mm_storeu_pd (&ar[j], _mm_add_pd (xr, tr));
+		_mm_storeu_pd (&ai[j], _mm_add_pd (xi, ti));
+	}
+
+	if (j < h) butterflySplitScalar (ar + j, ai + j, br + j, bi + j, wr + j, wi + j, h - j);
+
+}
+
+/* Radix-2 butterflies of a batch of frames (two frames per register, the remainder of each row is processed by scalar code) */
+
+__attribute__((target("sse2"))) void butterflyBatchSSE2 (double * const ar, double * const ai, double * const br, double * const bi, const complex * const w,
+	const unsigned int h, const unsigned int width) {
+
+	__m128d vr, vi, xr, xi, yr, yi, tr, ti;
+
+	unsigned int j, c, row;
+	for (j = 0, row = 0; j < h; j++, row += width) {
+		vr = _mm_set1_pd (w[j].real); 														/*The twiddle factor is loaded once for the whole row*/
+		vi = _mm_set1_pd (w[j].imag);
+		for (c = row; c + 2 <= row + width; c += 2) {
+			yr = _mm_loadu_pd (&br[c]);
+			yi = _mm_loadu_pd (&bi[c]);
+			tr = _mm_sub_pd (_mm_mul_pd (yr, vr), _mm_mul_pd (yi, vi));
+			ti = _mm_add_pd (_mm_mul_pd (yr, vi), _mm_mul_pd (yi, vr));
+			xr = _mm_loadu_pd (&ar[c]);
+			xi = _mm_loadu_pd (&ai[c]);
+			_mm_storeu_pd (&br[c], _mm_sub_pd (xr, tr));
+			_mm_storeu_pd (&bi[c], _mm_sub_pd (xi, ti));
+			_mm_storeu_pd (&ar[c], _mm_add_pd (xr, tr));
+			_mm_storeu_pd (&ai[c], _mm_add_pd (xi, ti));
+		}
+		if (c < row + width) butterflyBatchScalar (ar + c, ai + c, br + c, bi + c, &w[j], 1, row + width - c);
+	}
+
+}
+
+/* Radix-2 butterflies in single precision (two complex values per register, the remainder is processed by scalar code) */
+
+__attribute__((target("sse2"))) void butterflyFloatSSE2 (complexf * const a, complexf * const b, const complexf * const w, const unsigned int h) {
+
+	const __m128 sign = _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f); 								/*Real parts subtract, imaginary parts add*/
+
+	__m128 x, y, v, t;
+
+	unsigned int j;
+	for (j = 0; j + 2 <= h; j += 2) {
+		y = _mm_loadu_ps (&b[j].real);
+		v = _mm_loadu_ps (&w[j].real);
+		t = _mm_mul_ps (_mm_shuffle_ps (y, y, _MM_SHUFFLE (2, 3, 0, 1)), _mm_shuffle_ps (v, v, _MM_SHUFFLE (3, 3, 1, 1)));
+		t = _mm_add_ps (_mm_mul_ps (y, _mm_shuffle_ps (v, v, _MM_SHUFFLE (2, 2, 0, 0))), _mm_xor_ps (t, sign));
+		x = _mm_loadu_ps (&a[j].real);
+		_mm_storeu_ps (&b[j].real, _mm_sub_ps (x, t));
+		_mm_storeu_ps (&a[j].real, _mm_add_ps (x, t));
+	}
+
+	if (j < h) butterflyFloatScalar (a + j, b + j, w + j, h - j);
+
+}
+
+/* Twiddle multiplication (one complex value per register) */
+
+__attribute__((target("sse2"))) void multiplySSE2 (complex * const x, const complex * const w, const unsigned int n) {
+
+	unsigned int j;
+	for (j = 0; j < n; j++) {
+		_mm_storeu_pd (&x[j].real, mulSSE2 (_mm_loadu_pd (&x[j].real), _mm_loadu_pd (&w[j].real)));
+	}
+
+}
+
+/* FIR filtering (four outputs in two registers, the remainder is processed by scalar code) */
+
+__attribute__((target("sse2"))) void firSSE2 (const double * const x, const double * const h, const unsigned int m, double * const y,
+	const unsigned int n) {
+
+	__m128d tap, s0, s1;
+
+	unsigned int i, j;
+	for (i = 0; i + 4 <= n; i += 4) {
+		s0 = _mm_setzero_pd();
+		s1 = _mm_setzero_pd();
+		for (j = 0; j < m; j++) {
+			tap = _mm_set1_pd (h[j]);
+			s0 = _mm_add_pd (s0, _mm_mul_pd (tap, _mm_loadu_pd (&x[i + j])));
+			s1 = _mm_add_pd (s1, _mm_mul_pd (tap, _mm_loadu_pd (&x[i + j + 2])));
+		}
+		_mm_storeu_pd (&y[i], _mm_add_pd (_mm_loadu_pd (&y[i]), s0));
+		_mm_storeu_pd (&y[i + 2], _mm_add_pd (_mm_loadu_pd (&y[i + 2]), s1));
+	}
+
+	if (i < n) firScalar (x + i, h, m, y + i, n - i);
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- AVX2 kernels --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Product of two pairs of complex values, held by 256-bit registers as [real0, imag0, real1, imag1] */
+
+static inline __attribute__((target("avx2,fma"))) __m256d mulAVX2 (const __m256d x, const __m256d w) {
+
+	const __m256d wr = _mm256_movedup_pd (w); 												/*[w0.real, w0.real, w1.real, w1.real]*/
+	const __m256d wi = _mm256_permute_pd (w, 0xf); 											/*[w0.imag, w0.imag, w1.imag, w1.imag]*/
+	const __m256d xs = _mm256_permute_pd (x, 0x5); 											/*[x0.imag, x0.real, x1.imag, x1.real]*/
+
+	return _mm256_fmaddsub_pd (x, wr, _mm256_mul_pd (xs, wi)); 								/*Real parts subtract, imaginary parts add*/
+
+}
+
+/* Radix-2 butterflies (two complex values per register, the remainder is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void butterflyAVX2 (complex * const a, complex * const b, const complex * const w, const unsigned int h) {
+
+	__m256d x, t;
+
+	unsigned int j;
+	for (j = 0; j + 2 <= h; j += 2) {
+		t = mulAVX2 (_mm256_loadu_pd (&b[j].real), _mm256_loadu_pd (&w[j].real));
+		x = _mm256_loadu_pd (&a[j].real);
+		_mm256_storeu_pd (&b[j].real, _mm256_sub_pd (x, t));
+		_mm256_storeu_pd (&a[j].real, _mm256_add_pd (x, t));
+	}
+
+	if (j < h) butterflySSE2 (a + j, b + j, w + j, h - j);
+
+}
+
+/* Radix-2 butterflies on split-complex arrays (four values per register, the remainder is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void butterflySplitAVX2 (double * const ar, double * const ai, double * const br, double * const bi, const double * const wr,
+	const double * const wi, const unsigned int h) {
+
+	__m256d xr, xi, yr, yi, vr, vi, tr, ti;
+
+	unsigned int j;
+	for (j = 0; j + 4 <= h; j += 4) {
+		yr = _mm256_loadu_pd (&br[j]);
+		yi = _mm256_loadu_pd (&bi[j]);
+		vr = _mm256_loadu_pd (&wr[j]);
+		vi = _mm256_loadu_pd (&wi[j]);
+		tr = _mm256_fmsub_pd (yr, vr, _mm256_mul_pd (yi, vi));
+		ti = _mm256_fmadd_pd (yr, vi, _mm256_mul_pd (yi, vr));
+		xr = _mm256_loadu_pd (&ar[j]);
+		xi = _mm256_loadu_pd (&ai[j]);
+		_mm256_storeu_pd (&br[j], _mm256_sub_pd (xr, tr));
+		_mm256_storeu_pd (&bi[j], _mm256_sub_pd (xi, ti));
+		_mm256_storeu_pd (&ar[j], _mm256_add_pd (xr, tr));
+		_mm256_storeu_pd (&ai[j], _mm256_add_pd (xi, ti));
+	}
+
+	if (j < h) butterflySplitSSE2 (ar + j, ai + j, br + j, bi + j, wr + j, wi + j, h - j);
+
+}
+
+/* Radix-2 butterflies of a batch of frames (four frames per register, the remainder of each row is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void butterflyBatchAVX2 (double * const ar, double * const ai, double * const br, double * const bi, const complex * const w,
+	const unsigned int h, const unsigned int width) {
+
+	__m256d vr, vi, xr, xi, yr, yi, tr, ti;
+
+	unsigned int j, c, row;
+	for (j = 0, row = 0; j < h; j++, row += width) {
+		vr = _mm256_set1_pd (w[j].real); 													/*The twiddle factor is loaded once for the whole row*/
+		vi = _mm256_set1_pd (w[j].imag);
+		for (c = row; c + 4 <= row + width; c += 4) {
+			yr = _mm256_loadu_pd (&br[c]);
+			yi = _mm256_loadu_pd (&bi[c]);
+			tr = _mm256_fmsub_pd (yr, vr, _mm256_mul_pd (yi, vi));
+			ti = _mm256_fmadd_pd (yr, vi, _mm256_mul_pd (yi, vr));
+			xr = _mm256_loadu_pd (&ar[c]);
+			xi = _mm256_loadu_pd (&ai[c]);
+			_mm256_storeu_pd (&br[c], _mm256_sub_pd (xr, tr));
+			_mm256_storeu_pd (&bi[c], _mm256_sub_pd (xi, ti));
+			_mm256_storeu_pd (&ar[c], _mm256_add_pd (xr, tr));
+			_mm256_storeu_pd (&ai[c], _mm256_add_pd (xi, ti));
+		}
+		if (c < row + width) butterflyBatchSSE2 (ar + c, ai + c, br + c, bi + c, &w[j], 1, row + width - c);
+	}
+
+}
+
+/* Radix-2 butterflies in single precision (four complex values per register, the remainder is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void butterflyFloatAVX2 (complexf * const a, complexf * const b, const complexf * const w, const unsigned int h) {
+
+	__m256 x, y, v, t;
+
+	unsigned int j;
+	for (j = 0; j + 4 <= h; j += 4) {
+		y = _mm256_loadu_ps (&b[j].real);
+		v = _mm256_loadu_ps (&w[j].real);
+		t = _mm256_fmaddsub_ps (y, _mm256_moveldup_ps (v), _mm256_mul_ps (_mm256_permute_ps (y, 0xb1), _mm256_movehdup_ps (v)));
+		x = _mm256_loadu_ps (&a[j].real);
+		_mm256_storeu_ps (&b[j].real, _mm256_sub_ps (x, t));
+		_mm256_storeu_ps (&a[j].real, _mm256_add_ps (x, t));
+	}
+
+	if (j < h) butterflyFloatSSE2 (a + j, b + j, w + j, h - j);
+
+}
+
+/* Twiddle multiplication (two complex values per register, the remainder is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void multiplyAVX2 (complex * const x, const complex * const w, const unsigned int n) {
+
+	unsigned int j;
+	for (j = 0; j + 2 <= n; j += 2) {
+		_mm256_storeu_pd (&x[j].real, mulAVX2 (_mm256_loadu_pd (&x[j].real), _mm256_loadu_pd (&w[j].real)));
+	}
+
+	if (j < n) multiplySSE2 (x + j, w + j, n - j);
+
+}
+
+/* FIR filtering (eight outputs in two registers, the remainder is processed by SSE2) */
+
+__attribute__((target("avx2,fma"))) void firAVX2 (const double * const x, const double * const h, const unsigned int m, double * const y,
+	const unsigned int n) {
+
+	__m256d tap, s0, s1;
+
+	unsigned int i, j;
+	for (i = 0; i + 8 <= n; i += 8) {
+		s0 = _mm256_setzero_pd();
+		s1 = _mm256_setzero_pd();
+		for (j = 0; j < m; j++) {
+			tap = _mm256_set1_pd (h[j]);
+			s0 = _mm256_fmadd_pd (tap, _mm256_loadu_pd (&x[i + j]), s0);
+			s1 = _mm256_fmadd_pd (tap, _mm256_loadu_pd (&x[i + j + 4]), s1);
+		}
+		_mm256_storeu_pd (&y[i], _mm256_add_pd (_mm256_loadu_pd (&y[i]), s0));
+		_mm256_storeu_pd (&y[i + 4], _mm256_add_pd (_mm256_loadu_pd (&y[i + 4]), s1));
+	}
+
+	if (i < n) firSSE2 (x + i, h, m, y + i, n - i);
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- AVX-512 kernels ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Product of four pairs of complex values, held by 512-bit registers as [real0, imag0, ..., real3, imag3] */
+
+static inline __attribute__((target("avx512f"))) __m512d mulAVX512 (const __m512d x, const __m512d w) {
+
+	const __m512d wr = _mm512_movedup_pd (w);
+	const __m512d wi = _mm512_permute_pd (w, 0xff);
+	const __m512d xs = _mm512_permute_pd (x, 0x55);
+
+	return _mm512_fmaddsub_pd (x, wr, _mm512_mul_pd (xs, wi));
+
+}
+
+/* Radix-2 butterflies (four complex values per register, the remainder is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void butterflyAVX512 (complex * const a, complex * const b, const complex * const w, const unsigned int h) {
+
+	__m512d x, t;
+
+	unsigned int j;
+	for (j = 0; j + 4 <= h; j += 4) {
+		t = mulAVX512 (_mm512_loadu_pd (&b[j].real), _mm512_loadu_pd (&w[j].real));
+		x = _mm512_loadu_pd (&a[j].real);
+		_mm512_storeu_pd (&b[j].real, _mm512_sub_pd (x, t));
+		_mm512_storeu_pd (&a[j].real, _mm512_add_pd (x, t));
+	}
+
+	if (j < h) butterflyAVX2 (a + j, b + j, w + j, h - j);
+
+}
+
+/* Radix-2 butterflies on split-complex arrays (eight values per register, the remainder is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void butterflySplitAVX512 (double * const ar, double * const ai, double * const br, double * const bi,
+	const double * const wr, const double * const wi, const unsigned int h) {
+
+	__m512d xr, xi, yr, yi, vr, vi, tr, ti;
+
+	unsigned int j;
+	for (j = 0; j + 8 <= h; j += 8) {
+		yr = _mm512_loadu_pd (&br[j]);
+		yi = _mm512_loadu_pd (&bi[j]);
+		vr = _mm512_loadu_pd (&wr[j]);
+		vi = _mm512_loadu_pd (&wi[j]);
+		tr = _mm512_fmsub_pd (yr, vr, _mm512_mul_pd (yi, vi));
+		ti = _mm512_fmadd_pd (yr, vi, _mm512_mul_pd (yi, vr));
+		xr = _mm512_loadu_pd (&ar[j]);
+		xi = _mm512_loadu_pd (&ai[j]);
+		_mm512_storeu_pd (&br[j], _mm512_sub_pd (xr, tr));
+		_mm512_storeu_pd (&bi[j], _mm512_sub_pd (xi, ti));
+		_mm512_storeu_pd (&ar[j], _mm512_add_pd (xr, tr));
+		_mm512_storeu_pd (&ai[j], _mm512_add_pd (xi, ti));
+	}
+
+	if (j < h) butterflySplitAVX2 (ar + j, ai + j, br + j, bi + j, wr + j, wi + j, h - j);
+
+}
+
+/* Radix-2 butterflies of a batch of frames (eight frames per register, the remainder of each row is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void butterflyBatchAVX512 (double * const ar, double * const ai, double * const br, double * const bi, const complex * const w,
+	const unsigned int h, const unsigned int width) {
+
+	__m512d vr, vi, xr, xi, yr, yi, tr, ti;
+
+	unsigned int j, c, row;
+	for (j = 0, row = 0; j < h; j++, row += width) {
+		vr = _mm512_set1_pd (w[j].real); 													/*The twiddle factor is loaded once for the whole row*/
+		vi = _mm512_set1_pd (w[j].imag);
+		for (c = row; c + 8 <= row + width; c += 8) {
+			yr = _mm512_loadu_pd (&br[c]);
+			yi = _mm512_loadu_pd (&bi[c]);
+			tr = _mm512_fmsub_pd (yr, vr, _mm512_mul_pd (yi, vi));
+			ti = _mm512_fmadd_pd (yr, vi, _mm512_mul_pd (yi, vr));
+			xr = _mm512_loadu_pd (&ar[c]);
+			xi = _mm512_loadu_pd (&ai[c]);
+			_mm512_storeu_pd (&br[c], _mm512_sub_pd (xr, tr));
+			_mm512_storeu_pd (&bi[c], _mm512_sub_pd (xi, ti));
+			_mm512_storeu_pd (&ar[c], _mm512_add_pd (xr, tr));
+			_mm512_storeu_pd (&ai[c], _mm512_add_pd (xi, ti));
+		}
+		if (c < row + width) butterflyBatchAVX2 (ar + c, ai + c, br + c, bi + c, &w[j], 1, row + width - c);
+	}
+
+}
+
+/* Radix-2 butterflies in single precision (eight complex values per register, the remainder is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void butterflyFloatAVX512 (complexf * const a, complexf * const b, const complexf * const w, const unsigned int h) {
+
+	__m512 x, y, v, t;
+
+	unsigned int j;
+	for (j = 0; j + 8 <= h; j += 8) {
+		y = _mm512_loadu_ps (&b[j].real);
+		v = _mm512_loadu_ps (&w[j].real);
+		t = _mm512_fmaddsub_ps (y, _mm512_moveldup_ps (v), _mm512_mul_ps (_mm512_permute_ps (y, 0xb1), _mm512_movehdup_ps (v)));
+		x = _mm512_loadu_ps (&a[j].real);
+		_mm512_storeu_ps (&b[j].real, _mm512_sub_ps (x, t));
+		_mm512_storeu_ps (&a[j].real, _mm512_add_ps (x, t));
+	}
+
+	if (j < h) butterflyFloatAVX2 (a + j, b + j, w + j, h - j);
+
+}
+
+/* Twiddle multiplication (four complex values per register, the remainder is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void multiplyAVX512 (complex * const x, const complex * const w, const unsigned int n) {
+
+	unsigned int j;
+	for (j = 0; j + 4 <= n; j += 4) {
+		_mm512_storeu_pd (&x[j].real, mulAVX512 (_mm512_loadu_pd (&x[j].real), _mm512_loadu_pd (&w[j].real)));
+	}
+
+	if (j < n) multiplyAVX2 (x + j, w + j, n - j);
+
+}
+
+/* FIR filtering (sixteen outputs in two registers, the remainder is processed by AVX2) */
+
+__attribute__((target("avx512f"))) void firAVX512 (const double * const x, const double * const h, const unsigned int m, double * const y,
+	const unsigned int n) {
+
+	__m512d tap, s0, s1;
+
+	unsigned int i, j;
+	for (i = 0; i + 16 <= n; i += 16) {
+		s0 = _mm512_setzero_pd();
+		s1 = _mm512_setzero_pd();
+		for (j = 0; j < m; j++) {
+			tap = _mm512_set1_pd (h[j]);
+			s0 = _mm512_fmadd_pd (tap, _mm512_loadu_pd (&x[i + j]), s0);
+			s1 = _mm512_fmadd_pd (tap, _mm512_loadu_pd (&x[i + j + 8]), s1);
+		}
+		_mm512_storeu_pd (&y[i], _mm512_add_pd (_mm512_loadu_pd (&y[i]), s0));
+		_mm512_storeu_pd (&y[i + 8], _mm512_add_pd (_mm512_loadu_pd (&y[i + 8]), s1));
+	}
+
+	if (i < n) firAVX2 (x + i, h, m, y + i, n - i);
+
+}
+
+#endif
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------- Internal data structures and variables -------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Kernels table, indexed by instruction set extension (NULL entries haven't been compiled) */
+
+const dspKernel kernels[SIMD_COUNT] = {
+	{ SIMD_SCALAR, "scalar", butterflyScalar, butterflySplitScalar, butterflyBatchScalar, butterflyFloatScalar, multiplyScalar, firScalar },
+#ifdef X86_KERNELS
+	{ SIMD_SSE2, "SSE2", butterflySSE2, butterflySplitSSE2, butterflyBatchSSE2, butterflyFloatSSE2, multiplySSE2, firSSE2 },
+	{ SIMD_AVX2, "AVX2", butterflyAVX2, butterflySplitAVX2, butterflyBatchAVX2, butterflyFloatAVX2, multiplyAVX2, firAVX2 },
+	{ SIMD_AVX512, "AVX-512", butterflyAVX512, butterflySplitAVX512, butterflyBatchAVX512, butterflyFloatAVX512, multiplyAVX512, firAVX512 }
+#else
+	{ SIMD_SSE2, "SSE2", NULL, NULL, NULL, NULL, NULL, NULL },
+	{ SIMD_AVX2, "AVX2", NULL, NULL, NULL, NULL, NULL, NULL },
+	{ SIMD_AVX512, "AVX-512", NULL, NULL, NULL, NULL, NULL, NULL }
+#endif
+};
+
+/* Kernels chosen by kernelSelect(); (NULL until the first call) */
+
+const dspKernel *selected;
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+#ifdef X86_KERNELS
+
+/* Read the extended control register XCR0, to know which register states are saved by the OS */
+
+unsigned int readXCR0 (void) {
+
+	unsigned int eax, edx;
+
+	__asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+
+	return eax;
+
+}
+
+#endif
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Check if kernels for 'isa' have been compiled and if both the processor and the OS support them */
+
+boolean simdSupported (const simd isa) {
+
+#ifdef X86_KERNELS
+
+	unsigned int eax, ebx, ecx, edx;
+	unsigned int ebx7 = 0, ecx7 = 0, edx7 = 0;
+
+	if (isa == SIMD_SCALAR) return true;
+	if (isa >= SIMD_COUNT) return false;
+
+	if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx)) return false;
+	if (isa == SIMD_SSE2) return (edx & CPUID1_EDX_SSE2) ? true : false;
+
+	if (!(ecx & CPUID1_ECX_OSXSAVE) || !(ecx & CPUID1_ECX_AVX) || !(ecx & CPUID1_ECX_FMA)) return false;
+	if (__get_cpuid_max (0, NULL) >= 7) __cpuid_count (7, 0, eax, ebx7, ecx7, edx7);
+
+	if (isa == SIMD_AVX2) return ((ebx7 & CPUID7_EBX_AVX2) && (readXCR0() & XCR0_YMM) == XCR0_YMM) ? true : false;
+	return ((ebx7 & CPUID7_EBX_AVX2) && (ebx7 & CPUID7_EBX_AVX512F) && (readXCR0() & XCR0_ZMM) == XCR0_ZMM) ? true : false; 	/*AVX-512 kernels fall back on AVX2 ones*/
+
+#else
+
+	return (isa == SIMD_SCALAR) ? true : false;
+
+#endif
+
+}
+
+/* Return the kernels for 'isa', or NULL if they aren't supported */
+
+const dspKernel* kernelGet (const simd isa) {
+
+	if (!simdSupported (isa)) return NULL;
+
+	return &kernels[isa];
+
+}
+
+/* Return the kernels for the most powerful instruction set extension supported by the running processor */
+
+const dspKernel* kernelSelect (void) {
+
+	int isa;
+
+	if (selected == NULL) { 																/*Detection is idempotent: concurrent first calls simply repeat it*/
+		for (isa = SIMD_COUNT - 1; isa > SIMD_SCALAR && !simdSupported ((simd)isa); isa--);
+		selected = &kernels[isa];
+	}
+
+	return selected;
+
+}
@@ -0,0 +1,91 @@
+/*
+ * This library provides the computational kernels used by DSP functions, in a scalar version and in vectorized versions for the instruction set extensions
+ * of x86 processors (SSE2, AVX2, AVX-512). The best version supported by the running processor is chosen at run-time through the CPUID instruction, so
+ * that the same binary can be loaded on any target
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPKERNEL_H
+#define DSPKERNEL_H
+
+/* Parent library */
+
+#include "dsp.h"
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Instruction set extensions (from the least to the most powerful) */
+
+typedef enum simd {
+	SIMD_SCALAR = 0,
+	SIMD_SSE2 = 1,
+	SIMD_AVX2 = 2,
+	SIMD_AVX512 = 3
+} simd;
+
+#define SIMD_COUNT 									4
+
+/* Radix-2 butterflies: for 0<=j<h, t = b[j]*w[j], then b[j] = a[j] - t and a[j] = a[j] + t */
+
+typedef void (*butterflyKernel) (complex * const a, complex * const b, const complex * const w, const unsigned int h);
+
+/* Radix-2 butterflies on split-complex arrays: the same operation of butterflyKernel, with real and imaginary parts read from separate arrays */
+
+typedef void (*butterflySplitKernel) (double * const ar, double * const ai, double * const br, double * const bi, const double * const wr,
+	const double * const wi, const unsigned int h);
+
+/* Radix-2 butterflies of a batch of split-complex frames, whose values are stored in rows of 'width' frames: for 0<=j<h and 0<=c<width, the butterfly of
+ * butterflyKernel is applied to the value 'c' of rows 'j' of 'a' and 'b', with t = b[j*width+c]*w[j] (all the frames share the same twiddle factor) */
+
+typedef void (*butterflyBatchKernel) (double * const ar, double * const ai, double * const br, double * const bi, const complex * const w,
+	const unsigned int h, const unsigned int width);
+
+/* Single-precision version of butterflyKernel */
+
+typedef void (*butterflyFloatKernel) (complexf * const a, complexf * const b, const complexf * const w, const unsigned int h);
+
+/* Twiddle multiplication: for 0<=j<n, x[j] = x[j]*w[j] */
+
+typedef void (*multiplyKernel) (complex * const x, const complex * const w, const unsigned int n);
+
+/* FIR filtering (correlation with 'm' taps): for 0<=i<n, y[i] = y[i] + h[0]*x[i] + h[1]*x[i+1] + ... + h[m-1]*x[i+m-1]. Consecutive outputs are evaluated in
+ * the lanes of a register, so that 'x' is read contiguously and no horizontal sum is needed */
+
+typedef void (*firKernel) (const double * const x, const double * const h, const unsigned int m, double * const y, const unsigned int n);
+
+/* Set of kernels compiled for a specific instruction set extension */
+
+typedef struct dspKernel {
+
+	simd isa; 										/*Instruction set extension*/
+	const char *name; 								/*Printable name*/
+
+	butterflyKernel butterfly;
+	butterflySplitKernel butterflySplit;
+	butterflyBatchKernel butterflyBatch;
+	butterflyFloatKernel butterflyFloat;
+	multiplyKernel multiply;
+	firKernel fir;
+
+} dspKernel;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Dispatching ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Check if kernels for 'isa' have been compiled and if both the processor and the OS support them */
+
+boolean simdSupported (const simd isa);
+
+/* Return the kernels for 'isa', or NULL if they aren't supported (see simdSupported();) */
+
+const dspKernel* kernelGet (const simd isa);
+
+/* Return the kernels for the most powerful instruction set extension supported by the running processor (the scalar ones at least) */
+
+const dspKernel* kernelSelect (void);
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* H library */
+
+#include "dspParallel.h"
+
+/* Project private libraries */
+
+#include "dspKernel.h"
+
+/* Generic private libraries */
+
+#include "math.h"
+#include "stdio.h" 									/*For sprintf(); utility*/
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Pi */
+
+#define PI 											3.14159265358979323846
+
+/* Steps of the transform */
+
+#define STEP_COLUMNS 								0
+#define STEP_ROWS 									1
+
+/* Columns (or rows) transformed together by a worker: their results are transposed a cache line at a time */
+
+#define BLOCK 										8
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Service routines ------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Transform the columns from 'first' to 'last' (excluded) by 'plan', multiply them by the twiddle factors and write them transposed in 'engine->buffer' */
+
+void columnsStep (const fftParallel * const engine, const fftPlan * const plan, complex * const line, const unsigned int first, const unsigned int last) {
+
+	const unsigned int n1 = engine->n1;
+	const unsigned int n2 = engine->n2;
+
+	unsigned int width;
+
+	unsigned int j2, c, k1;
+	for (j2 = first; j2 < last; j2 += width) {
+		width = (last - j2 < BLOCK) ? last - j2 : BLOCK;
+		for (c = 0; c < width; c++) {
+			fftExecute_ (plan, engine->frameT + j2 + c, NULL, n2, line + c*n1);
+			plan->kernel->multiply (line + c*n1, engine->twiddle + (j2 + c)*n1, n1);
+		}
+		for (k1 = 0; k1 < n1; k1++) { 														/*Each row of the buffer receives 'width' adjacent values*/
+			for (c = 0; c < width; c++) engine->buffer[k1*n2 + j2 + c] = line[c*n1 + k1];
+		}
+	}
+
+}
+
+/* Transform the rows from 'first' to 'last' (excluded) of 'engine->buffer' by 'plan' and write them in the columns of 'engine->frameF' */
+
+void rowsStep (const fftParallel * const engine, const fftPlan * const plan, complex * const line, const unsigned int first, const unsigned int last) {
+
+	const unsigned int n1 = engine->n1;
+	const unsigned int n2 = engine->n2;
+
+	complex *row;
+	unsigned int width;
+
+	unsigned int k1, c, k2;
+	for (k1 = first; k1 < last; k1 += width) {
+		width = (last - k1 < BLOCK) ? last - k1 : BLOCK;
+		for (c = 0; c < width; c++) {
+			row = engine->buffer + (k1 + c)*n2;
+			fftExecute_ (plan, &row->real, &row->imag, 2, line + c*n2);
+		}
+		for (k2 = 0; k2 < n2; k2++) {
+			for (c = 0; c < width; c++) engine->frameF[k1 + c + n1*k2] = line[c*n2 + k2];
+		}
+	}
+
+}
+
+/* Execute the share of worker 'index' of the step in progress */
+
+void share (const fftParallel * const engine, const unsigned int index) {
+
+	const unsigned int count = (engine->step == STEP_COLUMNS) ? engine->n2 : engine->n1;
+	const unsigned int first = (unsigned int)(((unsigned long long)count*index)/engine->workers);
+	const unsigned int last = (unsigned int)(((unsigned long long)count*(index + 1))/engine->workers);
+
+	if (engine->step == STEP_COLUMNS) columnsStep (engine, engine->columns[index], engine->line[index], first, last);
+	else rowsStep (engine, engine->rows[index], engine->line[index], first, last);
+
+}
+
+/* Body of a worker task: execute its share of each step, until the engine is destroyed */
+
+void worker (fftParallel * const engine, const unsigned int index) {
+
+	while (true) {
+		semTake (engine->start[index], WAIT_FOREVER);
+		if (engine->quit) break;
+		share (engine, index);
+		semGive (engine->done);
+	}
+
+	semGive (engine->done); 																/*Acknowledge the end of the task*/
+
+}
+
+/* Run a step on all the workers, and wait for its end */
+
+void step (fftParallel * const engine, const unsigned int s) {
+
+	unsigned int w;
+
+	engine->step = s;
+
+	for (w = 1; w < engine->workers; w++) semGive (engine->start[w]);
+
+	share (engine, 0); 																		/*The calling task is worker 0*/
+
+	for (w = 1; w < engine->workers; w++) semTake (engine->done, WAIT_FOREVER);
+
+}
+
+/* Stop the first 'count' workers and release all the resources of 'engine' */
+
+void release (fftParallel * const engine, const unsigned int count) {
+
+	unsigned int w;
+
+	engine->quit = true;
+	for (w = 1; w < count; w++) semGive (engine->start[w]);
+	for (w = 1; w < count; w++) semTake (engine->done, WAIT_FOREVER);
+
+	for (w = 0; w < MAX_WORKERS; w++) {
+		if (engine->start[w] != NULL) semDelete (engine->start[w]);
+		free (engine->line[w]);
+		if (engine->columns[w] != NULL) fftDestroy (engine->columns[w]);
+		if (engine->rows[w] != NULL) fftDestroy (engine->rows[w]);
+	}
+	if (engine->done != NULL) semDelete (engine->done);
+	free (engine->twiddle);
+	free (engine->buffer);
+	free (engine);
+
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a parallel transform of length 'n', shared among 'workers' tasks */
+
+fftParallel* fftParallelCreate (const unsigned int n, const unsigned int workers, const int priority) {
+
+	fftParallel *engine;
+	char name[16];
+	unsigned int n1;
+
+	unsigned int w, j2, k1;
+
+	if (n == 0 || workers == 0 || workers > MAX_WORKERS) return NULL;
+
+	engine = (fftParallel*)calloc (1, sizeof (fftParallel)); 								/*Pointers start NULL: release(); can be called at any point*/
+	if (engine == NULL) return NULL;
+
+	for (n1 = (unsigned int)sqrt((double)n); n % n1 != 0; n1--);
+
+	engine->n = n;
+	engine->n1 = n1;
+	engine->n2 = n/n1;
+	engine->workers = workers;
+	engine->quit = false;
+	engine->twiddle = (complex*)malloc (n*sizeof (complex));
+	engine->buffer = (complex*)malloc (n*sizeof (complex));
+	engine->done = semCCreate (SEM_Q_PRIORITY, 0);
+
+	if (engine->twiddle == NULL || engine->buffer == NULL || engine->done == NULL) {
+		release (engine, 0);
+		return NULL;
+	}
+
+	for (j2 = 0; j2 < engine->n2; j2++) {
+		for (k1 = 0; k1 < n1; k1++) { 														/*j2*k1 is reduced modulo 'n' to keep the angle accurate*/
+			engine->twiddle[j2*n1 + k1].real = cos((2*PI*(((unsigned long long)j2*k1) % n))/n);
+			engine->twiddle[j2*n1 + k1].imag = -sin((2*PI*(((unsigned long long)j2*k1) % n))/n);
+		}
+	}
+
+	for (w = 0; w < workers; w++) {
+		engine->line[w] = (complex*)malloc (BLOCK*((n1 > engine->n2) ? n1 : engine->n2)*sizeof (complex));
+		engine->columns[w] = fftCreate (n1); 												/*The same plans, unless Bluestein ones (with a work buffer)*/
+		engine->rows[w] = fftCreate (engine->n2);
+		if (engine->line[w] == NULL || engine->columns[w] == NULL || engine->rows[w] == NULL) {
+			release (engine, w);
+			return NULL;
+		}
+		if (w == 0) continue; 																/*The calling task needs no semaphore*/
+		engine->start[w] = semBCreate (SEM_Q_PRIORITY, SEM_EMPTY);
+		if (engine->start[w] == NULL) {
+			release (engine, w);
+			return NULL;
+		}
+		sprintf (name, "tFft%u", w);
+		engine->task[w] = taskSpawn (name, priority, VX_FP_TASK, WORKER_STACK, (FUNCPTR)worker, (_Vx_usr_arg_t)engine, (_Vx_usr_arg_t)w,
+			0, 0, 0, 0, 0, 0, 0, 0);
+		if (engine->task[w] == TASK_ID_ERROR) {
+			release (engine, w);
+			return NULL;
+		}
+	}
+
+	return engine;
+
+}
+
+/* Evaluate the Fourier Transform of 'engine->n' samples contained in 'frameT' and write them in 'frameF' */
+
+void fftParallelExecute (fftParallel * const engine, const double * const frameT, complex * const frameF) {
+
+	engine->frameT = frameT;
+	engine->frameF = frameF;
+
+	step (engine, STEP_COLUMNS); 															/*Every row of the buffer needs all the columns: steps are separated*/
+	step (engine, STEP_ROWS);
+
+}
+
+/* Stop the workers of a parallel transform obtained by fftParallelCreate();, and release it */
+
+void fftParallelDestroy (fftParallel * const engine) {
+
+	release (engine, engine->workers);
+
+}
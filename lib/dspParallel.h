@@ -0,0 +1,84 @@
+/*
+ * This library provides a parallel version of the Fourier Transform for large frames (64k samples and more), split among a fixed set of worker tasks by the
+ * four-step decomposition: the transform of n = n1*n2 samples becomes n2 transforms of length n1, a twiddle multiplication and n1 transforms of length n2,
+ * each group shared among the workers
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPPARALLEL_H
+#define DSPPARALLEL_H
+
+/* Parent library */
+
+#include "dsp.h"
+
+/* VxWorks common libraries */
+
+#include "semLib.h"
+#include "taskLib.h"
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Maximum number of workers of a parallel transform (the calling task included) */
+
+#define MAX_WORKERS 								16
+
+/* Stack size of worker tasks */
+
+#define WORKER_STACK 								8192
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Parallel transform of length 'n = n1*n2'. Sample j = n2*j1 + j2 is column 'j2' of row 'j1', and bin k = k1 + n1*k2 is column 'k1' of row 'k2': columns
+ * are transformed first (length 'n1'), multiplied by exp(-j*2*PI*j2*k1/n) and transposed, then rows are transformed (length 'n2'). The calling task works
+ * as worker 0, while 'workers-1' tasks are spawned once and wait on a semaphore between transforms */
+
+typedef struct fftParallel {
+
+	unsigned int n; 								/*Length of the transform*/
+	unsigned int n1, n2; 							/*Factors of 'n': 'n1' is its largest divisor not greater than sqrt(n)*/
+	unsigned int workers; 							/*Number of workers, the calling task included*/
+
+	fftPlan *columns[MAX_WORKERS]; 					/*Plan of the transforms of length 'n1' of each worker (see fftCreate_();)...*/
+	fftPlan *rows[MAX_WORKERS]; 					/*...and of those of length 'n2'*/
+	complex *twiddle; 								/*exp(-j*2*PI*j2*k1/n), 'n1' values for each 'j2'*/
+	complex *buffer; 								/*Transposed results of the first step: row 'k1' holds 'n2' values*/
+	complex *line[MAX_WORKERS]; 					/*Private buffer of each worker*/
+
+	const double *frameT; 							/*Input of the transform in progress*/
+	complex *frameF; 								/*Output of the transform in progress*/
+	unsigned int step; 								/*Step in progress (columns or rows)*/
+	boolean quit; 									/*Set by fftParallelDestroy(); to stop the workers*/
+
+	TASK_ID task[MAX_WORKERS]; 						/*Spawned workers (the first entry isn't used)*/
+	SEM_ID start[MAX_WORKERS]; 						/*Given to a worker to start a step*/
+	SEM_ID done; 									/*Given by a worker at the end of a step*/
+
+} fftParallel;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------- Parallel transform ------------------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Create a parallel transform of length 'n', shared among 'workers' tasks (1<=workers<=MAX_WORKERS): 'workers-1' tasks are spawned with 'priority', which
+ * should be the one of the calling task, so that the workers run on the other cores while it works on its share. 'n' should have a divisor close to its
+ * square root (powers of 2 and products of small primes do): for prime lengths all the work falls on a single transform. NULL is returned if 'workers' is
+ * out of range or resources are exhausted. Call it outside the periodic activity */
+
+fftParallel* fftParallelCreate (const unsigned int n, const unsigned int workers, const int priority);
+
+/* Evaluate the Fourier Transform of 'engine->n' samples contained in 'frameT' and write them in 'frameF', the same result of fftExecute();. The calling task
+ * blocks until all the workers have finished: only one transform at a time can be in progress on 'engine' */
+
+void fftParallelExecute (fftParallel * const engine, const double * const frameT, complex * const frameF);
+
+/* Stop the workers of a parallel transform obtained by fftParallelCreate();, and release it */
+
+void fftParallelDestroy (fftParallel * const engine);
+
+#endif
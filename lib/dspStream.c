@@ -0,0 +1,554 @@
+/*
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+/* H library */
+
+#include "dspStream.h"
+
+/* Generic private libraries */
+
+#include "math.h"
+#include "stdlib.h" 								/*For malloc(); and free(); utilities*/
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions --------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Pi */
+
+#define PI 											3.14159265358979323846
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------- Main functions -------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Write the 'n' coefficients of the periodic window 'type' in 'window' */
+
+void windowFill (double * const window, const unsigned int n, const windowType type) {
+
+	double phase;
+
+	unsigned int k;
+	for (k = 0; k < n; k++) {
+		phase = (2*PI*k)/n; 																/*Periodic windows: 'n' (not 'n-1') is the period*/
+		switch (type) {
+			case (WINDOW_HANN):
+				window[k] = 0.5 - 0.5*cos(phase);
+				break;
+			case (WINDOW_HAMMING):
+				window[k] = 0.54 - 0.46*cos(phase);
+				break;
+			case (WINDOW_BLACKMAN):
+				window[k] = 0.42 - 0.5*cos(phase) + 0.08*cos(2*phase);
+				break;
+			default:
+				window[k] = 1;
+				break;
+		}
+	}
+
+}
+
+/* Create a STFT stage transforming frames of 'n' samples, weighted by the window 'type', every 'hop' samples, in the precision 'format' */
+
+stft* stftCreate_ (const unsigned int n, const unsigned int hop, const windowType type, const precision format, const double scale) {
+
+	const size_t bytes = (format == PRECISION_FLOAT) ? sizeof (float) : (format == PRECISION_Q15) ? sizeof (q15) : sizeof (double);
+	stft *stream;
+	void *history, *window, *frame; 														/*Buffers in the precision 'format'*/
+	double *coefficients; 																	/*Window in double precision (then converted to 'format')*/
+
+	if (n < 2 || n % 2 != 0 || hop == 0 || n % hop != 0) return NULL;
+	if (format != PRECISION_DOUBLE && ((n/2) & (n/2 - 1)) != 0) return NULL; 				/*Single-precision and Q15 transforms are radix-2 only*/
+
+	stream = (stft*)calloc (1, sizeof (stft)); 												/*Buffers of the other precisions stay NULL*/
+	if (stream == NULL) return NULL;
+
+	stream->n = n;
+	stream->hop = hop;
+	stream->size = n + hop; 																/*One hop more than a frame: the slot being acquired never overlaps the current frame*/
+	stream->head = 0;
+	stream->filled = 0;
+	stream->format = format;
+	stream->scale = scale;
+	history = malloc (stream->size*bytes);
+	window = malloc (n*bytes);
+	frame = malloc (n*bytes);
+	coefficients = (format == PRECISION_DOUBLE) ? (double*)window : (double*)malloc (n*sizeof (double));
+	stream->plan = rfftCreate (n);
+
+	if (history == NULL || window == NULL || frame == NULL || coefficients == NULL || stream->plan == NULL) {
+		if (stream->plan != NULL) rfftDestroy (stream->plan);
+		free (history);
+		free (window);
+		free (frame);
+		if (coefficients != window) free (coefficients);
+		free (stream);
+		return NULL;
+	}
+
+	windowFill (coefficients, n, type);
+	switch (format) {
+		case (PRECISION_FLOAT):
+			stream->historyFloat = (float*)history;
+			stream->windowFloat = (float*)window;
+			stream->frameFloat = (float*)frame;
+			floatFromReal (coefficients, stream->windowFloat, n);
+			break;
+		case (PRECISION_Q15):
+			stream->historyQ15 = (q15*)history;
+			stream->windowQ15 = (q15*)window;
+			stream->frameQ15 = (q15*)frame;
+			q15FromReal (coefficients, stream->windowQ15, n, 1); 							/*A coefficient of 1 is saturated to 1-2^-15*/
+			break;
+		default:
+			stream->history = (double*)history;
+			stream->window = (double*)window;
+			stream->frame = (double*)frame;
+			break;
+	}
+	if (coefficients != window) free (coefficients);
+
+	return stream;
+
+}
+
+/* Overload of the previous routine: create a STFT stage in double precision */
+
+stft* stftCreate (const unsigned int n, const unsigned int hop, const windowType type) {
+
+	return stftCreate_ (n, hop, type, PRECISION_DOUBLE, 1);
+
+}
+
+/* Return the slot where the next 'stream->hop' samples have to be acquired */
+
+double* stftSlot (const stft * const stream) {
+
+	if (stream->history == NULL) return NULL;
+
+	return stream->history + stream->head; 													/*'size' is a multiple of 'hop', so slots never wrap around*/
+
+}
+
+/* Single-precision and Q15 versions of stftSlot(); */
+
+float* stftSlotFloat (const stft * const stream) {
+
+	if (stream->historyFloat == NULL) return NULL;
+
+	return stream->historyFloat + stream->head;
+
+}
+
+q15* stftSlotQ15 (const stft * const stream) {
+
+	if (stream->historyQ15 == NULL) return NULL;
+
+	return stream->historyQ15 + stream->head;
+
+}
+
+/* Commit the hop acquired in the slot returned by stftSlot(); */
+
+STATUS stftPush (stft * const stream) {
+
+	stream->head += stream->hop;
+	if (stream->head == stream->size) stream->head = 0;
+
+	if (stream->filled < stream->n) stream->filled += stream->hop;
+
+	return (stream->filled < stream->n) ? FRAME_INCOMPLETE : OK;
+
+}
+
+/* Weight the current frame by the window, writing it in the windowed frame of the precision of the stage */
+
+STATUS stftWindow (stft * const stream) {
+
+	const unsigned int start = (stream->head + stream->hop) % stream->size; 				/*Oldest sample of the current frame...*/
+	const unsigned int first = (start > stream->head) ? stream->size - start : stream->n; 	/*...which may wrap around the end of the ring*/
+
+	unsigned int k;
+
+	if (stream->filled < stream->n) return FRAME_INCOMPLETE;
+
+	switch (stream->format) {
+		case (PRECISION_FLOAT):
+			for (k = 0; k < first; k++) stream->frameFloat[k] = stream->historyFloat[start + k]*stream->windowFloat[k];
+			for (k = first; k < stream->n; k++) stream->frameFloat[k] = stream->historyFloat[k - first]*stream->windowFloat[k];
+			break;
+		case (PRECISION_Q15): 																/*Products rounded back to Q15 (they can't overflow)*/
+			for (k = 0; k < first; k++) stream->frameQ15[k] = (q15)(((int)stream->historyQ15[start + k]*stream->windowQ15[k] + 16384) >> 15);
+			for (k = first; k < stream->n; k++) stream->frameQ15[k] = (q15)(((int)stream->historyQ15[k - first]*stream->windowQ15[k] + 16384) >> 15);
+			break;
+		default:
+			for (k = 0; k < first; k++) stream->frame[k] = stream->history[start + k]*stream->window[k];
+			for (k = first; k < stream->n; k++) stream->frame[k] = stream->history[k - first]*stream->window[k];
+			break;
+	}
+
+	return OK;
+
+}
+
+/* Evaluate the transform of the frame weighted by stftWindow();, writing the 'n/2+1' non-redundant bins in 'frameF' */
+
+STATUS stftTransform (const stft * const stream, complex * const frameF) {
+
+	if (stream->format != PRECISION_DOUBLE) return ERROR;
+
+	rfftExecute (stream->plan, stream->frame, frameF);
+
+	return OK;
+
+}
+
+/* Single-precision and Q15 versions of stftTransform(); */
+
+STATUS stftTransformFloat (const stft * const stream, complexf * const frameF) {
+
+	if (stream->format != PRECISION_FLOAT) return ERROR;
+
+	return rfftExecuteFloat (stream->plan, stream->frameFloat, frameF);
+
+}
+
+STATUS stftTransformQ15 (const stft * const stream, complexq15 * const frameF) {
+
+	if (stream->format != PRECISION_Q15) return ERROR;
+
+	return rfftExecuteQ15 (stream->plan, stream->frameQ15, frameF);
+
+}
+
+/* Overload of the two previous routines: window the current frame and transform it */
+
+STATUS stftExecute (stft * const stream, complex * const frameF) {
+
+	if (stream->format != PRECISION_DOUBLE) return ERROR;
+	if (stftWindow (stream) == FRAME_INCOMPLETE) return FRAME_INCOMPLETE;
+
+	return stftTransform (stream, frameF);
+
+}
+
+/* Single-precision and Q15 versions of stftExecute(); */
+
+STATUS stftExecuteFloat (stft * const stream, complexf * const frameF) {
+
+	if (stream->format != PRECISION_FLOAT) return ERROR;
+	if (stftWindow (stream) == FRAME_INCOMPLETE) return FRAME_INCOMPLETE;
+
+	return stftTransformFloat (stream, frameF);
+
+}
+
+STATUS stftExecuteQ15 (stft * const stream, complexq15 * const frameF) {
+
+	if (stream->format != PRECISION_Q15) return ERROR;
+	if (stftWindow (stream) == FRAME_INCOMPLETE) return FRAME_INCOMPLETE;
+
+	return stftTransformQ15 (stream, frameF);
+
+}
+
+/* Release a STFT stage obtained by stftCreate(); */
+
+void stftDestroy (stft * const stream) {
+
+	rfftDestroy (stream->plan);
+	free (stream->history); 																/*Only the buffers of the precision of the stage aren't NULL*/
+	free (stream->window);
+	free (stream->frame);
+	free (stream->historyFloat);
+	free (stream->windowFloat);
+	free (stream->frameFloat);
+	free (stream->historyQ15);
+	free (stream->windowQ15);
+	free (stream->frameQ15);
+	free (stream);
+
+}
+
+/* Create a sliding DFT over windows of 'n' samples, tracking the 'count' bins listed in 'bins' */
+
+sdft* sdftCreate (const unsigned int n, const unsigned int * const bins, const unsigned int count) {
+
+	sdft *bank;
+
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		if (bins[i] >= n) return NULL;
+	}
+
+	bank = (sdft*)malloc (sizeof (sdft));
+	if (bank == NULL) return NULL;
+
+	bank->n = n;
+	bank->count = count;
+	bank->position = 0;
+	bank->history = (double*)calloc (n, sizeof (double)); 									/*Before the first 'n' samples, the window is zero-padded*/
+	bank->twiddle = (complex*)malloc (count*sizeof (complex));
+	bank->value = (complex*)calloc (count, sizeof (complex));
+
+	if (bank->history == NULL || bank->twiddle == NULL || bank->value == NULL) {
+		free (bank->history);
+		free (bank->twiddle);
+		free (bank->value);
+		free (bank);
+		return NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		bank->twiddle[i].real = cos((2*PI*bins[i])/n);
+		bank->twiddle[i].imag = sin((2*PI*bins[i])/n);
+	}
+
+	return bank;
+
+}
+
+/* Update the bins of 'bank' with 'n' new samples contained in 'frameT' */
+
+void sdftUpdate (sdft * const bank, const double * const frameT, const unsigned int n) {
+
+	complex *value, *twiddle;
+	double delta, real;
+
+	unsigned int q, i;
+	for (q = 0; q < n; q++) {
+		delta = frameT[q] - bank->history[bank->position]; 									/*The newest sample replaces the oldest one...*/
+		bank->history[bank->position] = frameT[q];
+		if (++bank->position == bank->n) bank->position = 0;
+		for (i = 0; i < bank->count; i++) { 												/*...and every bin is rotated by one sample*/
+			value = &bank->value[i];
+			twiddle = &bank->twiddle[i];
+			real = value->real + delta;
+			value->real = real*twiddle->real - value->imag*twiddle->imag;
+			value->imag = real*twiddle->imag + value->imag*twiddle->real;
+		}
+	}
+
+}
+
+/* Write the current value of the selected bins in 'frameF' */
+
+void sdftRead (const sdft * const bank, complex * const frameF) {
+
+	unsigned int i;
+	for (i = 0; i < bank->count; i++) frameF[i] = bank->value[i];
+
+}
+
+/* Release a sliding DFT obtained by sdftCreate(); */
+
+void sdftDestroy (sdft * const bank) {
+
+	free (bank->history);
+	free (bank->twiddle);
+	free (bank->value);
+	free (bank);
+
+}
+
+/* Create a Goertzel filter bank over blocks of 'n' samples, tracking the 'count' bins listed in 'bins' */
+
+goertzel* goertzelCreate (const unsigned int n, const unsigned int * const bins, const unsigned int count) {
+
+	goertzel *bank;
+
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		if (bins[i] >= n) return NULL;
+	}
+
+	bank = (goertzel*)malloc (sizeof (goertzel));
+	if (bank == NULL) return NULL;
+
+	bank->n = n;
+	bank->count = count;
+	bank->position = 0;
+	bank->coefficient = (double*)malloc (count*sizeof (double));
+	bank->twiddle = (complex*)malloc (count*sizeof (complex));
+	bank->s1 = (double*)calloc (count, sizeof (double));
+	bank->s2 = (double*)calloc (count, sizeof (double));
+	bank->value = (complex*)calloc (count, sizeof (complex));
+
+	if (bank->coefficient == NULL || bank->twiddle == NULL || bank->s1 == NULL || bank->s2 == NULL || bank->value == NULL) {
+		goertzelDestroy (bank);
+		return NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		bank->twiddle[i].real = cos((2*PI*bins[i])/n);
+		bank->twiddle[i].imag = -sin((2*PI*bins[i])/n);
+		bank->coefficient[i] = 2*bank->twiddle[i].real;
+	}
+
+	return bank;
+
+}
+
+/* Feed 'bank' with 'n' new samples contained in 'frameT' */
+
+STATUS goertzelUpdate (goertzel * const bank, const double * const frameT, const unsigned int n) {
+
+	STATUS st = FRAME_INCOMPLETE;
+	double s0;
+
+	unsigned int q, i;
+	for (q = 0; q < n; q++) {
+		for (i = 0; i < bank->count; i++) { 												/*Resonators: s(t) = x(t) + 2*cos(w)*s(t-1) - s(t-2)*/
+			s0 = frameT[q] + bank->coefficient[i]*bank->s1[i] - bank->s2[i];
+			bank->s2[i] = bank->s1[i];
+			bank->s1[i] = s0;
+		}
+		if (++bank->position == bank->n) { 													/*End of a block: one more step with a null input gives s(n), then X = s(n) - exp(-j*w)*s(n-1)*/
+			for (i = 0; i < bank->count; i++) {
+				s0 = bank->coefficient[i]*bank->s1[i] - bank->s2[i];
+				bank->value[i].real = s0 - bank->twiddle[i].real*bank->s1[i];
+				bank->value[i].imag = -bank->twiddle[i].imag*bank->s1[i];
+				bank->s1[i] = 0;
+				bank->s2[i] = 0;
+			}
+			bank->position = 0;
+			st = OK;
+		}
+	}
+
+	return st;
+
+}
+
+/* Write the value of the selected bins over the last complete block in 'frameF' */
+
+void goertzelRead (const goertzel * const bank, complex * const frameF) {
+
+	unsigned int i;
+	for (i = 0; i < bank->count; i++) frameF[i] = bank->value[i];
+
+}
+
+/* Release a Goertzel filter bank obtained by goertzelCreate(); */
+
+void goertzelDestroy (goertzel * const bank) {
+
+	free (bank->coefficient);
+	free (bank->twiddle);
+	free (bank->s1);
+	free (bank->s2);
+	free (bank->value);
+	free (bank);
+
+}
+
+/* Reduce 'n' complex bins contained in 'frameF' to real values, written in 'frameR', according to 'type' */
+
+void spectrumReduce (const complex * const frameF, double * const frameR, const unsigned int n, const reduction type) {
+
+	unsigned int k;
+	for (k = 0; k < n; k++) frameR[k] = frameF[k].real*frameF[k].real + frameF[k].imag*frameF[k].imag;
+
+	if (type == REDUCTION_MAGNITUDE) {
+		for (k = 0; k < n; k++) frameR[k] = sqrt(frameR[k]);
+	}
+	else if (type == REDUCTION_DB) {
+		for (k = 0; k < n; k++) frameR[k] = 10*log10((frameR[k] > POWER_FLOOR) ? frameR[k] : POWER_FLOOR);
+	}
+
+}
+
+/* Create a spectrum averaging stage for spectra of 'bins' bins, producing an output every 'frames' spectra */
+
+spectrumAverage* averageCreate (const unsigned int bins, const averaging mode, const unsigned int frames, const double alpha, const reduction type,
+	const double scale) {
+
+	spectrumAverage *average;
+
+	if (bins == 0 || frames == 0 || (mode == AVERAGING_EXPONENTIAL && (alpha <= 0 || alpha > 1))) return NULL;
+
+	average = (spectrumAverage*)malloc (sizeof (spectrumAverage));
+	if (average == NULL) return NULL;
+
+	average->bins = bins;
+	average->mode = mode;
+	average->type = type;
+	average->frames = frames;
+	average->alpha = alpha;
+	average->scale = scale;
+	average->count = 0;
+	average->primed = false;
+	average->power = (double*)calloc (bins, sizeof (double));
+	average->result = (double*)calloc (bins, sizeof (double));
+
+	if (average->power == NULL || average->result == NULL) {
+		free (average->power);
+		free (average->result);
+		free (average);
+		return NULL;
+	}
+
+	return average;
+
+}
+
+/* Add the spectrum contained in 'frameF' to the average */
+
+STATUS averageUpdate (spectrumAverage * const average, const complex * const frameF) {
+
+	const double beta = 1 - average->alpha;
+
+	double *power = average->power;
+	double p, factor;
+
+	unsigned int k;
+	for (k = 0; k < average->bins; k++) {
+		p = frameF[k].real*frameF[k].real + frameF[k].imag*frameF[k].imag;
+		if (average->mode == AVERAGING_WELCH || !average->primed) power[k] += p; 			/*The exponential average starts from the first spectrum*/
+		else power[k] = beta*power[k] + average->alpha*p;
+	}
+	average->primed = true;
+
+	if (++average->count < average->frames) return FRAME_INCOMPLETE;
+
+	factor = (average->mode == AVERAGING_WELCH) ? average->scale/average->frames : average->scale;
+
+	for (k = 0; k < average->bins; k++) { 													/*Reduce the average, as if it was a spectrum of powers*/
+		p = factor*power[k];
+		if (average->type == REDUCTION_MAGNITUDE) average->result[k] = sqrt(p);
+		else if (average->type == REDUCTION_DB) average->result[k] = 10*log10((p > POWER_FLOOR) ? p : POWER_FLOOR);
+		else average->result[k] = p;
+	}
+
+	if (average->mode == AVERAGING_WELCH) {
+		for (k = 0; k < average->bins; k++) power[k] = 0; 									/*The next group starts from scratch*/
+	}
+	average->count = 0;
+
+	return OK;
+
+}
+
+/* Write the last reduced average in 'frameR' */
+
+void averageRead (const spectrumAverage * const average, double * const frameR) {
+
+	unsigned int k;
+	for (k = 0; k < average->bins; k++) frameR[k] = average->result[k];
+
+}
+
+/* Release a spectrum averaging stage obtained by averageCreate(); */
+
+void averageDestroy (spectrumAverage * const average) {
+
+	free (average->power);
+	free (average->result);
+	free (average);
+
+}
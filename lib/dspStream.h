@@ -0,0 +1,266 @@
+/*
+ * This library provides streaming DSP stages, which keep their state across frames: samples are acquired in small blocks (hops, or even single samples) and
+ * each stage emits its results as soon as enough history is available
+ * Author: Alessandro Trifoglio
+ * Last revision: 16/10/2026
+ */
+
+#ifndef DSPSTREAM_H
+#define DSPSTREAM_H
+
+/* Parent library */
+
+#include "dsp.h"
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- Definitions ---------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Messages (STATUS) */
+
+#define FRAME_INCOMPLETE 							0x3c5e91a7
+
+/* Power corresponding to the lowest value in dB (-300 dB): null bins don't give -infinity */
+
+#define POWER_FLOOR 								1e-30
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* ------------------------------------------------------ Shared (root) data structures and variables ------------------------------------------------------ */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Analysis windows (periodic versions, as required by overlapped transforms) */
+
+typedef enum windowType {
+	WINDOW_RECTANGULAR = 0,
+	WINDOW_HANN = 1,
+	WINDOW_HAMMING = 2,
+	WINDOW_BLACKMAN = 3
+} windowType;
+
+/* Short-Time Fourier Transform: a frame of 'n' samples is transformed every 'hop' acquired samples, so that consecutive frames overlap by 'n-hop' samples.
+ * Samples are acquired directly into a ring buffer one hop at a time and never moved: the only pass over a frame is the windowing one. The ring buffer,
+ * the window and the windowed frame are held in the precision of the transform only (the buffers of the other precisions are NULL), so that a frame in
+ * single precision or Q15 format takes a half or a quarter of the memory traffic, and samples are converted once per hop rather than once per frame */
+
+typedef struct stft {
+
+	unsigned int n; 								/*Length of a frame (even)*/
+	unsigned int hop; 								/*Samples acquired between consecutive frames ('n' is a multiple of it)*/
+	unsigned int size; 								/*Length of the ring buffer: 'n+hop'*/
+
+	unsigned int head; 								/*Index of the slot where the next hop is acquired (multiple of 'hop')*/
+	unsigned int filled; 							/*Samples acquired so far, up to 'n'*/
+
+	double *history; 								/*Ring buffer: the current frame is made of the 'n' samples preceding 'head'*/
+	double *window; 								/*Precomputed analysis window*/
+	double *frame; 									/*Windowed frame, input of the transform*/
+	float *historyFloat; 							/*The same buffers, in single precision...*/
+	float *windowFloat;
+	float *frameFloat;
+	q15 *historyQ15; 								/*...and in Q15 format (samples divided by 'scale')*/
+	q15 *windowQ15;
+	q15 *frameQ15;
+
+	precision format; 								/*Precision of the buffers and of the transform*/
+	double scale; 									/*Full-scale value of the samples (Q15 only)*/
+
+	rfftPlan *plan; 								/*Plan of the real transform of length 'n'*/
+
+} stft;
+
+/* Sliding DFT: selected bins of the transform of the last 'n' samples, updated at every sample in O(1) time per bin through the recursion
+ * X[k] = (X[k] + x(t) - x(t-n))*exp(j*2*PI*k/n). Its poles lie on the unit circle, so rounding errors are never damped: in double precision they grow as
+ * the square root of the number of samples (about 1e-10 times the input amplitude after 1e8 samples, with n=256) */
+
+typedef struct sdft {
+
+	unsigned int n; 								/*Length of the sliding window*/
+	unsigned int count; 							/*Number of selected bins*/
+
+	unsigned int position; 							/*Index of the oldest sample in 'history'*/
+	double *history; 								/*Ring buffer of the last 'n' samples (zeros before they are acquired)*/
+
+	complex *twiddle; 								/*exp(j*2*PI*k/n) for each selected bin 'k'*/
+	complex *value; 								/*Current value of each selected bin*/
+
+} sdft;
+
+/* Goertzel filter bank: selected bins of the transforms of consecutive blocks of 'n' samples. Each sample costs one real multiplication per bin, about a
+ * quarter of the sliding DFT, but results are available once per block */
+
+typedef struct goertzel {
+
+	unsigned int n; 								/*Length of a block*/
+	unsigned int count; 							/*Number of selected bins*/
+
+	unsigned int position; 							/*Samples accumulated in the current block*/
+
+	double *coefficient; 							/*2*cos(2*PI*k/n) for each selected bin 'k'*/
+	complex *twiddle; 								/*exp(-j*2*PI*k/n) for each selected bin 'k'*/
+	double *s1, *s2; 								/*Last two outputs of the resonator of each bin*/
+	complex *value; 								/*Value of each selected bin over the last complete block*/
+
+} goertzel;
+
+/* Reductions of complex bins to real values */
+
+typedef enum reduction {
+	REDUCTION_MAGNITUDE = 0, 						/*|X[k]|*/
+	REDUCTION_POWER = 1, 							/*|X[k]|^2*/
+	REDUCTION_DB = 2 								/*10*log10(|X[k]|^2)*/
+} reduction;
+
+/* Averaging of consecutive power spectra */
+
+typedef enum averaging {
+	AVERAGING_WELCH = 0, 							/*Mean of each group of 'frames' spectra, which don't overlap (the frames they come from may do)*/
+	AVERAGING_EXPONENTIAL = 1 						/*P = (1-alpha)*P + alpha*|X|^2 at every spectrum, read every 'frames' spectra*/
+} averaging;
+
+/* Spectrum averaging stage: power spectra are averaged bin by bin, and the average is reduced once every 'frames' spectra, so that the sink receives a
+ * real value per bin every 'frames' transforms instead of a complex one per bin at every transform. Magnitudes and dB are evaluated on the averaged power */
+
+typedef struct spectrumAverage {
+
+	unsigned int bins; 								/*Number of bins of each spectrum*/
+	averaging mode; 								/*Averaging method*/
+	reduction type; 								/*Reduction applied by averageRead();*/
+	unsigned int frames; 							/*Spectra between consecutive outputs*/
+	double alpha; 									/*Weight of the last spectrum (exponential averaging only)*/
+	double scale; 									/*Factor applied to the power of each bin*/
+
+	unsigned int count; 							/*Spectra accumulated since the last output*/
+	boolean primed; 								/*Whether the exponential average has received its first spectrum*/
+	double *power; 									/*Sum (Welch) or average (exponential) of the power of each bin*/
+	double *result; 								/*Reduced average, ready to be read*/
+
+} spectrumAverage;
+
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/* --------------------------------------------------------------------- Streaming DSP --------------------------------------------------------------------- */
+/* --------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/* Write the 'n' coefficients of the periodic window 'type' in 'window' */
+
+void windowFill (double * const window, const unsigned int n, const windowType type);
+
+/* Create a STFT stage transforming frames of 'n' samples, weighted by the window 'type', every 'hop' samples, in the precision 'format'. With PRECISION_Q15,
+ * acquired samples are divided by 'scale' (the full-scale value of the input) and bins represent X[k]/(n*scale) (see rfftExecuteQ15();). NULL is returned
+ * if 'n' isn't even, 'hop' isn't a divisor of 'n', 'format' isn't PRECISION_DOUBLE and 'n/2' isn't a power of 2, or memory is exhausted. Call it outside
+ * the periodic activity */
+
+stft* stftCreate_ (const unsigned int n, const unsigned int hop, const windowType type, const precision format, const double scale);
+
+/* Overload of the previous routine: create a STFT stage in double precision */
+
+stft* stftCreate (const unsigned int n, const unsigned int hop, const windowType type);
+
+/* Return the slot where the next 'stream->hop' samples have to be acquired (for instance by acquireFromFile();). The slot isn't part of the current frame,
+ * so it can be filled while another task windows that frame. NULL is returned if the stage isn't in double precision */
+
+double* stftSlot (const stft * const stream);
+
+/* Single-precision and Q15 versions of stftSlot();: samples are converted into the slot by floatFromReal(); or q15FromReal(); (with the full-scale value
+ * of the stage). NULL is returned if the stage isn't in the precision of the routine */
+
+float* stftSlotFloat (const stft * const stream);
+q15* stftSlotQ15 (const stft * const stream);
+
+/* Commit the hop acquired in the slot returned by stftSlot();: return OK if a complete frame is available, FRAME_INCOMPLETE while the first 'n' samples are
+ * still being acquired */
+
+STATUS stftPush (stft * const stream);
+
+/* Weight the current frame by the window, writing it in the windowed frame of the precision of the stage. FRAME_INCOMPLETE is returned (and nothing is
+ * done) if fewer than 'n' samples have been acquired. When the producer of hops is another task, this is the only call to be made in mutual exclusion
+ * with stftPush(); */
+
+STATUS stftWindow (stft * const stream);
+
+/* Evaluate the transform of the frame weighted by stftWindow();, writing the 'n/2+1' non-redundant bins in 'frameF'. ERROR is returned (and 'frameF' is
+ * left untouched) if the stage isn't in double precision */
+
+STATUS stftTransform (const stft * const stream, complex * const frameF);
+
+/* Single-precision and Q15 versions of stftTransform(); (see rfftExecuteFloat(); and rfftExecuteQ15();). ERROR is returned if the stage isn't in the
+ * precision of the routine */
+
+STATUS stftTransformFloat (const stft * const stream, complexf * const frameF);
+STATUS stftTransformQ15 (const stft * const stream, complexq15 * const frameF);
+
+/* Overload of the two previous routines: window the current frame and transform it. FRAME_INCOMPLETE is returned (and 'frameF' is left untouched) if fewer
+ * than 'n' samples have been acquired, ERROR if the stage isn't in double precision */
+
+STATUS stftExecute (stft * const stream, complex * const frameF);
+
+/* Single-precision and Q15 versions of stftExecute(); */
+
+STATUS stftExecuteFloat (stft * const stream, complexf * const frameF);
+STATUS stftExecuteQ15 (stft * const stream, complexq15 * const frameF);
+
+/* Release a STFT stage obtained by stftCreate(); */
+
+void stftDestroy (stft * const stream);
+
+/* Create a sliding DFT over windows of 'n' samples, tracking the 'count' bins listed in 'bins'. NULL is returned if a bin isn't lower than 'n' or memory is
+ * exhausted. Call it outside the periodic activity */
+
+sdft* sdftCreate (const unsigned int n, const unsigned int * const bins, const unsigned int count);
+
+/* Update the bins of 'bank' with 'n' new samples contained in 'frameT' (from a single sample up to any number), in O(1) time per sample and bin */
+
+void sdftUpdate (sdft * const bank, const double * const frameT, const unsigned int n);
+
+/* Write the current value of the selected bins in 'frameF' ('bank->count' complex values, in the order of creation): they are the same of sft(); evaluated
+ * on the last 'bank->n' samples, up to rounding errors */
+
+void sdftRead (const sdft * const bank, complex * const frameF);
+
+/* Release a sliding DFT obtained by sdftCreate(); */
+
+void sdftDestroy (sdft * const bank);
+
+/* Create a Goertzel filter bank over blocks of 'n' samples, tracking the 'count' bins listed in 'bins'. NULL is returned if a bin isn't lower than 'n' or
+ * memory is exhausted. Call it outside the periodic activity */
+
+goertzel* goertzelCreate (const unsigned int n, const unsigned int * const bins, const unsigned int count);
+
+/* Feed 'bank' with 'n' new samples contained in 'frameT', in O(1) time per sample and bin: return OK if at least one block has been completed, whose values
+ * can be read by goertzelRead();, FRAME_INCOMPLETE otherwise */
+
+STATUS goertzelUpdate (goertzel * const bank, const double * const frameT, const unsigned int n);
+
+/* Write the value of the selected bins over the last complete block in 'frameF' ('bank->count' complex values, in the order of creation) */
+
+void goertzelRead (const goertzel * const bank, complex * const frameF);
+
+/* Release a Goertzel filter bank obtained by goertzelCreate(); */
+
+void goertzelDestroy (goertzel * const bank);
+
+/* Reduce 'n' complex bins contained in 'frameF' to real values, written in 'frameR', according to 'type' */
+
+void spectrumReduce (const complex * const frameF, double * const frameR, const unsigned int n, const reduction type);
+
+/* Create a spectrum averaging stage for spectra of 'bins' bins, producing an output every 'frames' spectra. 'alpha' (0<alpha<=1) is the weight of the last
+ * spectrum with AVERAGING_EXPONENTIAL, and it's ignored with AVERAGING_WELCH. The power of each bin is multiplied by 'scale' (for instance 1/sum(w^2),
+ * for the window 'w', to get a power spectral density per bin). NULL is returned if 'bins' or 'frames' is 0, 'alpha' is out of range or memory is
+ * exhausted. Call it outside the periodic activity */
+
+spectrumAverage* averageCreate (const unsigned int bins, const averaging mode, const unsigned int frames, const double alpha, const reduction type,
+	const double scale);
+
+/* Add the spectrum contained in 'frameF' ('average->bins' complex values) to the average: return OK once every 'average->frames' spectra, when a reduced
+ * average can be read by averageRead();, FRAME_INCOMPLETE otherwise */
+
+STATUS averageUpdate (spectrumAverage * const average, const complex * const frameF);
+
+/* Write the last reduced average in 'frameR' ('average->bins' real values) */
+
+void averageRead (const spectrumAverage * const average, double * const frameR);
+
+/* Release a spectrum averaging stage obtained by averageCreate(); */
+
+void averageDestroy (spectrumAverage * const average);
+
+#endif